@@ -30,7 +30,7 @@ Vector2f Character::getPosition() const {
 }
 
 Location Character::getLocation() const {
-	return mapToLevel(MAZE_X, SIZE, sprite.getPosition());
+	return GRID_TRANSFORM.toLevel(sprite.getPosition());
 }
 
 float Character::getOrientation() const {
@@ -4,9 +4,10 @@
 using namespace std;
 
 
-MonsterNearby::MonsterNearby(Character* character_, Character* monster_) {
+MonsterNearby::MonsterNearby(Character* character_, Character* monster_, const PathTable* table_) {
 	character = character_;
 	monster = monster_;
+	table = table_;
 }
 MonsterSequence::MonsterSequence(const vector<MonsterTask*>& children_) {
 	children = children_;
@@ -18,12 +19,13 @@ MonsterRandomSelector::MonsterRandomSelector(const vector<MonsterTask*>& childre
 	children = children_;
 }
 
-MonsterBehaviorTree::MonsterBehaviorTree(const Graph& graph_, Character* character_, Character* monster_, float* dt_) : graph(graph_) {
+MonsterBehaviorTree::MonsterBehaviorTree(const GraphHandle& graph_, Character* character_, Character* monster_, float* dt_,
+	const PathTable* table_, PathCache* cache_, PathService* service_) :
+	graph(graph_), table(table_), cache(cache_), service(service_) {
 	dt = dt_;
 	character = character_;
 	monster = monster_;
-	search = new AStar(graph, monster->getLocation(), monster->getLocation(), CustomHeuristic(monster->getLocation()));
-	pathFollowing = new FollowPath(path, PATH_OFFSET, 0, PREDICTION_TIME, TIME_TO_REACH_TARGET_SPEED, RADIUS_OF_ARRIVAL, RADIUS_OF_DECELERATION, MAX_SPEED);
+	pathFollowing = new FollowPath(path, GRID_TRANSFORM, PATH_OFFSET, 0, PREDICTION_TIME, TIME_TO_REACH_TARGET_SPEED, RADIUS_OF_ARRIVAL, RADIUS_OF_DECELERATION, MAX_SPEED);
 	wander = new Wander(
 		WANDER_OFFSET, WANDER_RADIUS, WANDER_RATE, WANDER_ORIENTATION, WANDER_MAX_ACCELERATION,
 		TIME_TO_REACH_TARGET_SPEED, WANDER_RADIUS_OF_ARRIVAL, WANDER_RADIUS_OF_DECELERATION, MAX_SPEED
@@ -31,7 +33,7 @@ MonsterBehaviorTree::MonsterBehaviorTree(const Graph& graph_, Character* charact
 
 	// Create sequence branch.
 	vector<MonsterTask*> sequenceChildren;
-	MonsterTask* isNearby = new MonsterNearby(character, monster);
+	MonsterTask* isNearby = new MonsterNearby(character, monster, table);
 	MonsterTask* chase = new MonsterChasing;
 	sequenceChildren.push_back(isNearby);
 	sequenceChildren.push_back(chase);
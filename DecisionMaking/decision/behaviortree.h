@@ -3,10 +3,17 @@
 
 #include <stddef.h>
 #include <cmath>
+#include <memory>
 #include "../character/character.h"
 #include "../environment/environment.h"
 #include "../search/search.h"
 #include "../search/a*.h"
+#include "../search/searchcontext.h"
+#include "../search/pathtable.h"
+#include "../search/pathcache.h"
+#include "../search/dstarlite.h"
+#include "../search/pathservice.h"
+#include "../search/boundedsearch.h"
 #include "../level/location.h"
 #include "../steering/steering.h"
 #include "../kinematic/kinematic.h"
@@ -34,12 +41,19 @@ class MonsterNearby : public MonsterTask
     const float MAX_D = 10.f;
     Character* character;
     Character* monster;
+    const PathTable* table;
 
     public:
-    MonsterNearby(Character* character_, Character* monster_);
+    MonsterNearby(Character* character_, Character* monster_, const PathTable* table_);
     inline MonsterAction run() {
         auto enemyLocation = character->getLocation();
         auto monsterLocation = monster->getLocation();
+
+        // Path distance when tabled (walls count for their cost), otherwise straight line distance.
+        if (table != nullptr && table->contains(enemyLocation) && table->contains(monsterLocation)) {
+            float distance = table->getDistance(monsterLocation, enemyLocation);
+            return distance >= 0 && distance < MAX_D ? chasing : nothing;
+        }
         float distance = sqrt(pow(enemyLocation.x - monsterLocation.x, 2) + pow(enemyLocation.y - monsterLocation.y, 2));
         bool nearby = distance < MAX_D;
         return nearby ? chasing : nothing;
@@ -160,7 +174,10 @@ class MonsterBehaviorTree
 
     /** Observable state for action code. */
     float* dt;
-    Graph graph;
+    GraphHandle graph;
+    const PathTable* table;
+    PathCache* cache;
+    PathService* service;
     Character* character;
 
     /** Root node. */
@@ -172,8 +189,14 @@ class MonsterBehaviorTree
 
     /** Monster movement path functionality. */
     Path path;
-    AStar* search;
     FollowPath* pathFollowing;
+
+    /** Search state, built on first use (never with path tables covering the level). */
+    unique_ptr<SearchContext> context;
+    unique_ptr<DStarLite> planner;
+    shared_ptr<PathTicket> chaseTicket;
+    Location chaseStart = Location(-1, -1);
+    Location chaseEnd = Location(-1, -1);
     int chasingIteration = 0;
     int chasingPauseIteration = 0;
     bool chasingPause = false;
@@ -187,8 +210,80 @@ class MonsterBehaviorTree
     int guessIteration = 0;
     bool guessPause = false;
 
+    /** Returns the search context, building it on first use. */
+    inline SearchContext& getContext() {
+        if (context == nullptr) { context.reset(new SearchContext(graph->size())); }
+        return *context;
+    }
+
+    /** Returns the chase's D* Lite planner, building it on first use. */
+    inline DStarLite& getPlanner() {
+        if (planner == nullptr) { planner.reset(new DStarLite(graph)); }
+        return *planner;
+    }
+
+    /**
+     * Finds the path from start to end, read off the path table when it has both, otherwise through
+     * the path cache when there is one. Optimal tells whether heuristic is admissible.
+     */
+    inline void findPath(const Location& start, const Location& end, const Heuristic& heuristic, bool optimal) {
+        if (table != nullptr && table->contains(start) && table->contains(end)) { table->getPath(start, end, path); }
+        else if (cache != nullptr) { cache->search(start, end, heuristic, optimal, getContext(), path); }
+        else { AStar::search(*graph, start, end, heuristic, getContext(), path); }
+    }
+
+    /**
+     * Replans the chase when the monster or the character moved to another cell. In order: read off
+     * the path table when it has both cells (always, with PATH_TABLES on), else requested from the
+     * path service when there is one and the monster has a chase path to keep to meanwhile (one
+     * request at a time), else the last plan is repaired with D* Lite, as when a chase begins.
+     */
+    inline void replanChase() {
+        Location start = monster->getLocation();
+        Location end = character->getLocation();
+        if (!graph->contains(start) || !graph->contains(end)) { return; }
+
+        // Follow a requested path once it arrives, and ask again if the request ended without one.
+        if (chaseTicket != nullptr && !chaseTicket->isPending()) {
+            if (chaseTicket->isReady() && !chaseTicket->getPath().isEmpty()) {
+                path = chaseTicket->getPath();
+                pathFollowing->setPath(path);
+            }
+            else { chaseStart = Location(-1, -1); }
+            chaseTicket.reset();
+        }
+        if (start == chaseStart && end == chaseEnd) { return; }
+        if (table != nullptr && table->contains(start) && table->contains(end)) {
+            table->getPath(start, end, path);
+            pathFollowing->setPath(path);
+        }
+        else if (service != nullptr && chaseStart.x != -1) {
+            if (chaseTicket != nullptr) { return; }
+            chaseTicket = service->request(start, end, make_shared<ManhattanHeuristic>(end));
+        }
+        else {
+            getPlanner().plan(start, end, path);
+            pathFollowing->setPath(path);
+        }
+        chaseStart = start;
+        chaseEnd = end;
+    }
+
     public:
     bool isChasing = false;
+
+    /**
+     * Cancels the chase's request in flight, which is stale once the monster stops chasing or the
+     * tree is replaced.
+     */
+    inline void cancelChase() {
+        if (chaseTicket != nullptr) {
+            chaseTicket->cancel();
+            chaseTicket.reset();
+        }
+        chaseStart = Location(-1, -1);
+    }
+
     inline MonsterAction generateAction(MonsterAction decision) {
         MonsterAction newDecision = decision;
         while (newDecision != decision) {
@@ -234,20 +329,20 @@ class MonsterBehaviorTree
                 auto p2 = p;
                 auto p3 = p;
                 auto p4 = p;
-                p1.x += 29.0909 / 2.f; // Right.
-                p2.x -= 29.0909 / 2.f; // Left.
-                p3.y += 29.0909 / 2.f; // Up.
-                p4.y -= 29.0909 / 2.f; // Down.
+                p1.x += GRID_TRANSFORM.getTileSize() / 2.f; // Right.
+                p2.x -= GRID_TRANSFORM.getTileSize() / 2.f; // Left.
+                p3.y += GRID_TRANSFORM.getTileSize() / 2.f; // Up.
+                p4.y -= GRID_TRANSFORM.getTileSize() / 2.f; // Down.
 
 
                 auto p5 = p1;
                 auto p6 = p2;
                 auto p7 = p3;
                 auto p8 = p4;
-                p5.y += 29.0909 / 2.f; // Right.
-                p6.y -= 29.0909 / 2.f; // Left.
-                p7.x += 29.0909 / 2.f; // Up.
-                p8.x -= 29.0909 / 2.f; // Down.
+                p5.y += GRID_TRANSFORM.getTileSize() / 2.f; // Right.
+                p6.y -= GRID_TRANSFORM.getTileSize() / 2.f; // Left.
+                p7.x += GRID_TRANSFORM.getTileSize() / 2.f; // Up.
+                p8.x -= GRID_TRANSFORM.getTileSize() / 2.f; // Down.
 
                 vector<Vector2f> neighbors;
                 neighbors.push_back(p1);
@@ -261,7 +356,7 @@ class MonsterBehaviorTree
 
                 bool found = false;
                 for (const auto& neighbor : neighbors) {
-                    auto v = mapToLevel(22, 29.0909, neighbor);
+                    auto v = GRID_TRANSFORM.toLevel(neighbor);
                     if (!(v == Location(-1, -1))) {
                         found = true;
                         monster->moveTo(neighbor);
@@ -271,10 +366,8 @@ class MonsterBehaviorTree
                     exit(99);
                 }
             }
-            search = new AStar(graph, monster->getLocation(), character->getLocation(), CustomHeuristic(character->getLocation()));
-            path = search->search();
-            // path.print();
-            pathFollowing = new FollowPath(path, PATH_OFFSET, 0, PREDICTION_TIME, TIME_TO_REACH_TARGET_SPEED, RADIUS_OF_ARRIVAL, RADIUS_OF_DECELERATION, MAX_SPEED);
+            cancelChase();
+            replanChase();
         }
 
         // If chasingIteration has complete, reset count. TODO: Probably bad way to do this.
@@ -298,10 +391,9 @@ class MonsterBehaviorTree
                 WANDER_OFFSET, WANDER_RADIUS, WANDER_RATE, WANDER_ORIENTATION, WANDER_MAX_ACCELERATION,
                 TIME_TO_REACH_TARGET_SPEED, RADIUS_OF_ARRIVAL, RADIUS_OF_DECELERATION, MAX_SPEED
             );
-            search = new AStar(graph, monster->getLocation(), monster->getLocation(), CustomHeuristic(monster->getLocation()));
-            path = search->search();
+            findPath(monster->getLocation(), monster->getLocation(), WeightedHeuristic(monster->getLocation(), SUBOPTIMALITY_BOUND), false);
             // path.print();
-            pathFollowing = new FollowPath(path, PATH_OFFSET, 0, PREDICTION_TIME, TIME_TO_REACH_TARGET_SPEED, RADIUS_OF_ARRIVAL, RADIUS_OF_DECELERATION, MAX_SPEED);
+            pathFollowing->setPath(path);
         }
 
         return true;
@@ -318,6 +410,7 @@ class MonsterBehaviorTree
 
     inline void preCheck(MonsterAction decision) {
         if (lastDecision == chasing && decision != chasing) {
+            cancelChase();
             chasingIteration = 0;
             chasingPauseIteration= 0;
             monster->stop();
@@ -405,7 +498,7 @@ class MonsterBehaviorTree
     inline Vector2f makeGuess(const Vector2f& p) {
         float timer = 0.0;
         Vector2f guessPosition(makeRandom(p), makeRandom(p));
-        while (mapToLevel(22, 29.0909, guessPosition) == Location(-1, -1)) {
+        while (GRID_TRANSFORM.toLevel(guessPosition) == Location(-1, -1)) {
             guessPosition = Vector2f(makeRandom(p), makeRandom(p));
             if (timer > 5.0) {
                 return p;
@@ -415,7 +508,8 @@ class MonsterBehaviorTree
         return guessPosition;
     }
 
-    MonsterBehaviorTree(const Graph& graph_, Character* character_, Character* monster_, float* dt_);
+    MonsterBehaviorTree(const GraphHandle& graph_, Character* character_, Character* monster_, float* dt_, const PathTable* table_ = nullptr, PathCache* cache_ = nullptr,
+        PathService* service_ = nullptr);
 
     inline void run() {
         auto decision = setupAction(root->run());
@@ -424,6 +518,7 @@ class MonsterBehaviorTree
             case chasing:
                 {
                     cout << "CHASING" << endl;
+                    replanChase();
                     SteeringOutput pathAccelerations = pathFollowing->calculateAcceleration(monster->getKinematic(), Kinematic());
                     if (pathAccelerations.linearAcceleration == Vector2f(-1.f, -1.f)) {
                         monster->stop();
@@ -451,7 +546,7 @@ class MonsterBehaviorTree
                     check.linearVelocity.y = monster->getKinematic().linearVelocity.y;
                     check.angularVelocity = monster->getKinematic().angularVelocity;
                     check.update(wanderAccelerations, *dt, true);
-                    if (mapToLevel(22, 29.09, check.position) == Location(-1, -1)) {
+                    if (GRID_TRANSFORM.toLevel(check.position) == Location(-1, -1)) {
                         monster->update(SteeringOutput(), *dt, true);
                     }
                     else {
@@ -480,7 +575,7 @@ class MonsterBehaviorTree
 
     inline int getChasingIteration() { return chasingIteration; }
 
-    inline Path getPath() { return path; }
+    inline const Path& getPath() const { return path; }
 };
 
 #endif
\ No newline at end of file
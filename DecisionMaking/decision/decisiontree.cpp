@@ -5,7 +5,9 @@ CharacterDecisionNode::CharacterDecisionNode(CharacterAction action_, CharacterD
     action = action_;
 }
 
-CharacterDecisionTree::CharacterDecisionTree(const Graph& graph_, Character* character_, Location* mouse_, float* dt_, bool* monsterClose_, bool* followingPath_) : graph(graph_) {
+CharacterDecisionTree::CharacterDecisionTree(const GraphHandle& graph_, Character* character_, Location* mouse_, float* dt_, bool* monsterClose_, bool* followingPath_,
+    const PathTable* table_, PathCache* cache_, SearchScheduler* scheduler_) :
+    graph(graph_), table(table_), cache(cache_), scheduler(scheduler_), context(graph_->size()), slicedSearch(graph_) {
     dt = dt_;
     character = character_;
     mouseLocation = mouse_;
@@ -16,7 +18,6 @@ CharacterDecisionTree::CharacterDecisionTree(const Graph& graph_, Character* cha
     CharacterDecisionNode* isFollowingClickDecisionNode = new CharacterDecisionNode(CharacterAction::followClick, followClickActionNode, sittingActionNode);
     CharacterDecisionNode* escapingActionNode = new CharacterDecisionNode(CharacterAction::escaping, NULL, NULL);
     root = new CharacterDecisionNode(CharacterAction::escaping, escapingActionNode, isFollowingClickDecisionNode);
-    search = new AStar(graph, character->getLocation(), *mouseLocation, ManhattanHeuristic(*mouseLocation));
-    pathFollowing = new FollowPath(path, PATH_OFFSET, 0, PREDICTION_TIME, TIME_TO_REACH_TARGET_SPEED, RADIUS_OF_ARRIVAL, RADIUS_OF_DECELERATION, MAX_SPEED);
+    pathFollowing = new FollowPath(path, GRID_TRANSFORM, PATH_OFFSET, 0, PREDICTION_TIME, TIME_TO_REACH_TARGET_SPEED, RADIUS_OF_ARRIVAL, RADIUS_OF_DECELERATION, MAX_SPEED);
 }
 
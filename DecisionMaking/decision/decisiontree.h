@@ -6,6 +6,11 @@
 #include "../environment/environment.h"
 #include "../search/search.h"
 #include "../search/a*.h"
+#include "../search/searchcontext.h"
+#include "../search/pathtable.h"
+#include "../search/pathcache.h"
+#include "../search/slicedsearch.h"
+#include "../search/boundedsearch.h"
 #include "../level/location.h"
 #include "../steering/steering.h"
 #include "../kinematic/kinematic.h"
@@ -83,7 +88,10 @@ class CharacterDecisionTree
 
     /** Observable state for action code. */
     float* dt;
-    Graph graph;
+    GraphHandle graph;
+    const PathTable* table;
+    PathCache* cache;
+    SearchScheduler* scheduler;
     Location* mouseLocation;
 
 
@@ -92,16 +100,75 @@ class CharacterDecisionTree
 
     /** followClick decision functionality. */
     Path path;
-    AStar* search;
+    SearchContext context;
     FollowPath* pathFollowing;
     int followingIteration = 0;
     int escapingIteration = 0;
 
+    /** Search spread over frames by the scheduler, whether its path is awaited, and whether it is optimal. */
+    SlicedAStar slicedSearch;
+    bool awaitingPath = false;
+    bool slicedOptimal = false;
+
+    /** True once a path arrives, until it is taken. */
+    bool newPath = false;
+
     /** escaping functionality*/
     Vector2f escapeEndPoint = Vector2f(1, 1);
 
+    /**
+     * Finds the path from start to end, read off the path table when it has both, otherwise through
+     * the path cache when there is one. Optimal tells whether heuristic is admissible. With a
+     * scheduler, a search the cache misses is begun instead and the path stays empty until the
+     * scheduler completes it over the next frames (see receivePath).
+     */
+    inline void findPath(const Location& start, const Location& end, const shared_ptr<const Heuristic>& heuristic, bool optimal) {
+        newPath = true;
+        awaitingPath = false;
+        if (table != nullptr && table->contains(start) && table->contains(end)) { table->getPath(start, end, path); }
+        else if (scheduler != nullptr) {
+            if (cache != nullptr && cache->lookup(start, end, *heuristic, path)) { return; }
+            path.clear();
+            slicedSearch.begin(start, end, heuristic);
+            scheduler->submit(slicedSearch);
+            slicedOptimal = optimal;
+            awaitingPath = true;
+            newPath = false;
+        }
+        else if (cache != nullptr) { cache->search(start, end, *heuristic, optimal, context, path); }
+        else { AStar::search(*graph, start, end, *heuristic, context, path); }
+    }
+
+    /**
+     * Finds a path from start to end costing at most SUBOPTIMALITY_BOUND times the shortest, read
+     * off the path table when it has both, otherwise with weighted A* (BoundedSearch), which also
+     * reports the bound it proved in Path::bound. Such paths are neither cached nor sliced.
+     */
+    inline void findBoundedPath(const Location& start, const Location& end) {
+        newPath = true;
+        awaitingPath = false;
+        if (table != nullptr && table->contains(start) && table->contains(end)) { table->getPath(start, end, path); }
+        else { BoundedSearch::search(*graph, start, end, ManhattanHeuristic(end), SUBOPTIMALITY_BOUND, WEIGHTED_SEARCH, context, path); }
+    }
+
+    /** Follows the path of the sliced search once the scheduler completed it. */
+    inline void receivePath() {
+        if (!awaitingPath || slicedSearch.isSearching()) { return; }
+        awaitingPath = false;
+        if (slicedSearch.getStatus() != SEARCH_COMPLETE) { return; }
+        path = slicedSearch.getPath();
+        const Location& start = slicedSearch.getStart();
+        const Location& end = slicedSearch.getEnd();
+        if (cache != nullptr && graph->contains(start) && graph->contains(end)) {
+            cache->insert(start, end, slicedSearch.getHeuristic(), slicedOptimal, path);
+        }
+        pathFollowing->setPath(path);
+        newPath = true;
+    }
+
     public:
-    CharacterDecisionTree(const Graph& graph, Character* character_, Location* mouse_, float* dt, bool* monsterClose_, bool* followingPath_);
+    CharacterDecisionTree(const GraphHandle& graph, Character* character_, Location* mouse_, float* dt, bool* monsterClose_, bool* followingPath_,
+        const PathTable* table_ = nullptr, PathCache* cache_ = nullptr, SearchScheduler* scheduler_ = nullptr);
 
     inline float makeRandom(const Vector2f& p) {
         int offset = 200;
@@ -127,7 +194,7 @@ class CharacterDecisionTree
     inline Vector2f makeGuess(const Vector2f& p) {
         float timer = 0.0;
         Vector2f guessPosition(makeRandom(p), makeRandom(p));
-        while (mapToLevel(22, 29.0909, guessPosition) == Location(-1, -1)) {
+        while (GRID_TRANSFORM.toLevel(guessPosition) == Location(-1, -1)) {
             guessPosition = Vector2f(makeRandom(p), makeRandom(p));
             if (timer > 5.0) {
                 cout << "BAD" << endl;
@@ -142,14 +209,14 @@ class CharacterDecisionTree
     inline void makeDecision() {
         cout << "CLOSE? " << *monsterClose << endl;
         CharacterAction action = root->makeDecision(*monsterClose, *followingPath).getAction();
+        receivePath();
 
         // If first iteration of followingClick, find path.
         cout << "IT: " << followingIteration << endl;
         if (action == followClick && followingIteration == 0) {
-            search = new AStar(graph, character->getLocation(), *mouseLocation, ManhattanHeuristic(*mouseLocation));
-            path = search->search();
+            findPath(character->getLocation(), *mouseLocation, make_shared<ManhattanHeuristic>(*mouseLocation), true);
             path.print();
-            pathFollowing = new FollowPath(path, PATH_OFFSET, 0, PREDICTION_TIME, TIME_TO_REACH_TARGET_SPEED, RADIUS_OF_ARRIVAL, RADIUS_OF_DECELERATION, MAX_SPEED);
+            pathFollowing->setPath(path);
         }
         // If first iteration of escape, find path.
         if (action == escaping && followingIteration == 0) {
@@ -157,12 +224,11 @@ class CharacterDecisionTree
             cout << "HERE WE ARE" << endl;
             cout << "START: " << character->getLocation().x << " " << character->getLocation().y << endl;
             escapeEndPoint = makeGuess(character->getPosition());
-            Location escapeEndPointLocation = mapToLevel(22, 29.0909, escapeEndPoint);
+            Location escapeEndPointLocation = GRID_TRANSFORM.toLevel(escapeEndPoint);
             cout << "END: " << escapeEndPointLocation.x << " " << escapeEndPointLocation.y << endl;
-            search = new AStar(graph, character->getLocation(), escapeEndPointLocation, CustomHeuristic(escapeEndPointLocation));
-            path = search->search();
+            findBoundedPath(character->getLocation(), escapeEndPointLocation);
             path.print();
-            pathFollowing = new FollowPath(path, PATH_OFFSET, 0, PREDICTION_TIME, TIME_TO_REACH_TARGET_SPEED, RADIUS_OF_ARRIVAL, RADIUS_OF_DECELERATION, MAX_SPEED);
+            pathFollowing->setPath(path);
         }
 
         // If followingClick has complete, reset count.
@@ -178,8 +244,8 @@ class CharacterDecisionTree
                     // Need to fix start position error...
                     // Apply path following to click.
                     // TODO: Keeps accelerating even if out of bounds...because velocity neeeds to be set to 0... kinda hacky
-                    SteeringOutput pathAccelerations = pathFollowing->calculateAcceleration(character->getKinematic(), Kinematic());
-                    if (pathAccelerations.linearAcceleration == Vector2f(-1.f, -1.f)) {
+                    SteeringOutput pathAccelerations = awaitingPath ? SteeringOutput() : pathFollowing->calculateAcceleration(character->getKinematic(), Kinematic());
+                    if (awaitingPath || pathAccelerations.linearAcceleration == Vector2f(-1.f, -1.f)) {
                         character->stop(); // TODO: more hacking to be put here.
                     }
                     else {
@@ -191,8 +257,8 @@ class CharacterDecisionTree
             case CharacterAction::escaping:
                 {
                     cout << "ESCAPING" << endl;
-                    SteeringOutput pathAccelerations = pathFollowing->calculateAcceleration(character->getKinematic(), Kinematic());
-                    if (pathAccelerations.linearAcceleration == Vector2f(-1.f, -1.f)) {
+                    SteeringOutput pathAccelerations = awaitingPath ? SteeringOutput() : pathFollowing->calculateAcceleration(character->getKinematic(), Kinematic());
+                    if (awaitingPath || pathAccelerations.linearAcceleration == Vector2f(-1.f, -1.f)) {
                         character->stop(); // TODO: more hacking to be put here.
                     }
                     else {
@@ -210,7 +276,14 @@ class CharacterDecisionTree
 
     inline int getFollowingIteration() { return followingIteration; }
 
-    inline Path getPath() { return path; }
+    inline const Path& getPath() const { return path; }
+
+    /** Returns true once after each new path (found right away or over frames by the scheduler). */
+    inline bool takeNewPath() {
+        bool taken = newPath;
+        newPath = false;
+        return taken;
+    }
 };
 
 
@@ -1,17 +1,32 @@
 #include <SFML/Graphics.hpp>
 #include "../level/level.h"
 #include "../graph/graph.h"
+#include "../search/pathtable.h"
+#include "../search/pathcache.h"
+#include "../hparams/hyperparameters.h"
 #include "environment.h"
 
-Environment::Environment() : level(generateCharacterLevel()), graph(levelToGraph(level, true)) {
+Environment::Environment() : level(generateCharacterLevel()), graph(makeGraphHandle(levelToGraph(level, true))) {
     Environment::rows = level.rows;
     Environment::cols = level.cols;
+
+    // The level never changes, so its tables are computed once and cached on disk.
+    if (PATH_TABLES) { pathTable = make_shared<const PathTable>(graph, PATH_TABLE_CACHE); }
+
+    // Paths the tables do not answer are searched through a cache of the level's graph.
+    if (PATH_CACHE_CAPACITY > 0) { pathCache = make_shared<PathCache>(graph, PATH_CACHE_CAPACITY); }
 }
 
-Graph Environment::getGraph() const {
+const GraphHandle& Environment::getGraph() const {
     return graph;
 }
-Level Environment::getLevel() const {
+const PathTable* Environment::getPathTable() const {
+    return pathTable.get();
+}
+PathCache* Environment::getPathCache() const {
+    return pathCache.get();
+}
+const Level& Environment::getLevel() const {
     return level;
 }
 int Environment::getRows() const { return rows; }
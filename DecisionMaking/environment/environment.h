@@ -4,6 +4,8 @@
 #include <SFML/Graphics.hpp>
 #include "../level/level.h"
 #include "../graph/graph.h"
+#include "../search/pathtable.h"
+#include "../search/pathcache.h"
 
 using namespace sf;
 
@@ -17,17 +19,23 @@ class Environment
 
     Level level;
 
-    Graph graph;
+    GraphHandle graph;
+
+    /** All-pairs path tables of the level (null unless PATH_TABLES). */
+    shared_ptr<const PathTable> pathTable;
+
+    /** Cache of searched paths on the graph (null unless PATH_CACHE_CAPACITY). */
+    shared_ptr<PathCache> pathCache;
 
     Environment();
 
     inline Location localize(const graph::Vertex& vertex) {
-        return graph.localize(vertex);
+        return graph->localize(vertex);
     }
 
     inline GraphNode quantize(const Location& location) {
         cout << "GOD DAMMIT" << endl;
-        auto x = graph.quantize(location);
+        auto x = graph->quantize(location);
         cout << "NOOOOOOOOO" << endl;
         return x;
     }
@@ -42,8 +50,10 @@ class Environment
         }
     }
 
-    Graph getGraph() const;
-    Level getLevel() const;
+    const GraphHandle& getGraph() const;
+    const PathTable* getPathTable() const;
+    PathCache* getPathCache() const;
+    const Level& getLevel() const;
     int getRows() const;
     int getCols() const;
 };
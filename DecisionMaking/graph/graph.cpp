@@ -1,8 +1,8 @@
 #include <vector>
-#include <unordered_map>
-#include <stack>
 #include <iostream>
-#include "../id/id.h"
+#include <cmath>
+#include <climits>
+#include <algorithm>
 #include "../level/location.h"
 #include "graph.h"
 
@@ -10,77 +10,34 @@ using namespace std;
 
 namespace graph {
 
-    Vertex::Vertex() {
-        id = ID();
-    }
-
-    int Vertex::getID() const { return id.getID(); }
-
-    void Vertex::setID(int id) { Vertex::id.setID(id); }
-
-    Edge::Edge(float w, float c, Vertex f, Vertex t) {
-        weight = w;
-        cost = c;
-        from = f;
-        to = t;
-    }
-
-    float Edge::getCost() const {
-        return cost;
-    }
-    graph::Vertex Edge::getFromVertex() const {
-        return from;
-    }
-
-    graph::Vertex Edge::getToVertex() const {
-        return to;
-    }
-
-    GraphNode::GraphNode(const Location& location, const Vertex& vertex, const vector<Edge>& edges) :
-        location(location.x, location.y) {
-        GraphNode::location = location;
-        GraphNode::vertex = vertex;
-        GraphNode::edges = edges;
-    }
-
-    Vertex GraphNode::getVertex() const { return vertex; }
-
-    Location GraphNode::getLocation() const { return location; }
-
-    vector<Edge> GraphNode::getEdges() const { return edges; }
-
-    void GraphNode::setEdges(const vector<Edge>& edges) { GraphNode::edges = edges; }
-
-    void GraphNode::appendEdges(const vector<Edge>& edges) {
-        for (const auto& edge : edges) {
-            GraphNode::edges.push_back(edge);
-        }
-    }
-
-
-    Graph::Graph(int rows, int cols, const unordered_map<int, GraphNode>& nodes) {
+    Graph::Graph(int rows, int cols, const vector<int>& offsets, const vector<int>& targets, const vector<float>& costs) :
+        offsets(offsets), targets(targets), costs(costs), maxIntegerCost(0) {
         Graph::rows = rows;
         Graph::cols = cols;
-        Graph::nodes = nodes;
-        unordered_map<Location, GraphNode> localizer;
 
-        // TODO: Id here...may be bad.
-        for (const auto& kv : nodes) { localizer.insert({ kv.second.getLocation(), kv.second }); }
-        Graph::localizer = localizer;
+        // Integer costs let searches use bucket queues instead of heaps.
+        for (float cost : costs) {
+            if (cost < 0 || cost != floor(cost) || cost > INT_MAX) {
+                maxIntegerCost = -1;
+                break;
+            }
+            maxIntegerCost = max(maxIntegerCost, int(cost));
+        }
     }
 
-    Graph::Graph(const Graph& graph) {
-        nodes = graph.nodes;
-        localizer = graph.localizer;
-        rows = graph.rows;
-        cols = graph.cols;
+    vector<int> openCells(const Graph& graph) {
+        vector<int> cells;
+        for (int vertex = 0; vertex < graph.size(); vertex++) {
+            if (!graph.getOutgoingEdges(vertex).isEmpty()) { cells.push_back(vertex); }
+        }
+        return cells;
     }
 
-    int Graph::getRows() { return rows; }
+    int Graph::getRows() const { return rows; }
 
-    int Graph::getCols() { return cols; }
+    int Graph::getCols() const { return cols; }
 
-    void Graph::print() {
+    void Graph::print() const {
         cout << rows << endl;
         cout << cols << endl;
         for (int i = 0; i < rows; i++) {
@@ -92,13 +49,13 @@ namespace graph {
         }
     }
 
-    void Graph::printy() {
+    void Graph::printy() const {
         for (int i = 0; i < rows; i++) {
             for (int j = 0; j < cols; j++) {
                 // cout << "===========================================" << endl;
                 // cout << "from " << "(" << i << ", " << j << ")" << endl << endl;
                 GraphNode node = quantize(Location(i, j));
-                for (const auto& edge : node.getEdges()) {
+                for (const auto& edge : getOutgoingEdges(node.getVertex())) {
                     Location from = localize(edge.getFromVertex());
                     Location to = localize(edge.getToVertex());
                     // cout << "\tto " << "(" << to.x << ", " << to.y << ")";
@@ -109,4 +66,4 @@ namespace graph {
             // cout << endl << endl;
         }
     }
-};
\ No newline at end of file
+};
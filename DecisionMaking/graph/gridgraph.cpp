@@ -0,0 +1,84 @@
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "../level/location.h"
+#include "../level/level.h"
+#include "graph.h"
+#include "gridgraph.h"
+
+using namespace std;
+
+namespace graph {
+
+    GridGraph::GridGraph() : rows(0), cols(0), cells(nullptr), maxIntegerCost(1) {
+        for (int k = 0; k < 4; k++) {
+            costs[k] = 1.0;
+            offsets[k] = 0;
+            deltas[k][0] = 0;
+            deltas[k][1] = 0;
+        }
+    }
+
+    bool GridGraph::isDeadEnd(int vertex) const {
+        if (!cells[vertex].inLevel) { return false; }
+        int row = vertex / cols;
+        int col = vertex - row * cols;
+        for (int k = 0; k < 4; k++) {
+            if (hasEdge(vertex, row, col, k)) { return false; }
+        }
+        return true;
+    }
+
+    GridGraph::GridGraph(const Level& level, bool flag, bool jumps) : rows(level.rows), cols(level.cols), cells(level.cells.data()), maxIntegerCost(0) {
+        for (int k = 0; k < 4; k++) {
+            costs[k] = flag ? mapConnectionCost(ConnectionCost(k)) : 1.0;
+            deltas[k][0] = level.NEIGHBORS[k][0];
+            deltas[k][1] = level.NEIGHBORS[k][1];
+            offsets[k] = deltas[k][0] * cols + deltas[k][1];
+        }
+
+        // Costs come from a table, so the range is known without looking at any cell.
+        for (int k = 0; k < 4; k++) {
+            if (costs[k] < 0 || costs[k] != floor(costs[k])) { maxIntegerCost = -1; break; }
+            maxIntegerCost = max(maxIntegerCost, int(costs[k]));
+        }
+        if (!jumps) { return; }
+
+        // Uniform cells: normal cost and an edge to every in level neighbor.
+        vector<unsigned char> uniform(rows * cols, false);
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                int vertex = i * cols + j;
+                if (!inLevel(vertex) || getCost(vertex) != getUniformCost()) { continue; }
+                bool all = true;
+                bool any = false;
+                for (int k = 0; k < 4; k++) {
+                    int nx = i + deltas[k][0];
+                    int ny = j + deltas[k][1];
+                    bool neighbor = nx >= 0 && nx < rows && ny >= 0 && ny < cols && cells[vertex + offsets[k]].inLevel;
+                    all = all && (!neighbor || cells[vertex].hasDirection(k));
+                    any = any || (neighbor && cells[vertex].hasDirection(k));
+                }
+                uniform[vertex] = all && any;
+            }
+        }
+
+        // Jumpable cells: uniform cells off the border surrounded by uniform, out of level or closed dead end cells.
+        jumpable.assign(rows * cols, false);
+        for (int i = 1; i + 1 < rows; i++) {
+            for (int j = 1; j + 1 < cols; j++) {
+                if (!uniform[i * cols + j]) { continue; }
+                bool plain = true;
+                for (int dx = -1; dx <= 1 && plain; dx++) {
+                    for (int dy = -1; dy <= 1 && plain; dy++) {
+                        int nx = i + dx;
+                        int ny = j + dy;
+                        if (!inLevel(nx * cols + ny)) { continue; }
+                        plain = uniform[nx * cols + ny] || !hasDirections(nx * cols + ny);
+                    }
+                }
+                jumpable[i * cols + j] = plain;
+            }
+        }
+    }
+};
@@ -0,0 +1,196 @@
+#ifndef GRID_GRAPH_H
+#define GRID_GRAPH_H
+
+#include <vector>
+#include "../level/location.h"
+#include "../level/level.h"
+#include "graph.h"
+
+using namespace std;
+
+namespace graph {
+
+    /**
+     * Outgoing edges of one grid cell, computed on the fly (a cell has at most four).
+     * Has the same interface as EdgeRange, so searches run on either graph.
+     */
+    class GridEdgeRange
+    {
+        private:
+        /** Vertex the edges start at. */
+        int from;
+
+        /** Targets and costs of the edges. */
+        int targets[4];
+        float costs[4];
+
+        /** Number of outgoing edges. */
+        int count;
+
+        public:
+
+        /** Constructs an empty range of edges from vertex from. */
+        inline GridEdgeRange(int from) : from(from), count(0) {}
+
+        /** Adds an edge to target of the given cost. */
+        inline void add(int target, float cost) {
+            targets[count] = target;
+            costs[count] = cost;
+            count++;
+        }
+
+        /** Returns the i-th outgoing edge. */
+        inline Edge operator[](int i) const { return Edge(costs[i], Vertex(from), Vertex(targets[i])); }
+
+        /** Returns the dense index of the i-th edge's end vertex. */
+        inline int target(int i) const { return targets[i]; }
+
+        /** Returns the cost of the i-th edge. */
+        inline float cost(int i) const { return costs[i]; }
+
+        /** Getters. */
+        inline int size() const { return count; }
+        inline bool isEmpty() const { return count == 0; }
+    };
+
+    /**
+     * Implicit graph over a tile level: a view of the level's cells (one byte each) instead of
+     * stored edges, so the level must outlive it. A cell has an edge in each direction the level
+     * allows if the neighbor is in bounds and both are in the level, costing the neighbor's
+     * ConnectionCost. Neighbors and costs are computed from the cell bytes on demand. Vertices are
+     * numbered like Graph (row * cols + col), so the same searches, locations and paths work on both.
+     *
+     * A cell is a dead end if it is in the level but has no outgoing edges (like the walls of
+     * generateCharacterLevel()); paths only ever end in one. A cell is uniform if it costs as much
+     * as a normal cell and has an edge to every in level neighbor. A cell is jumpable if it is
+     * uniform, not on the border and each of the eight cells around it is uniform, out of the level
+     * or a dead end allowing no direction: there the grid is a plain unit grid, which jump point
+     * search relies on. A jumpable cell has an edge to each neighbor in the level, which is a dead
+     * end exactly if it allows no direction. Only this bit is stored, and only if asked for.
+     */
+    class GridGraph
+    {
+        private:
+
+        /** Number of rows to represent graph. */
+        int rows;
+
+        /** Number of columns to represent graph. */
+        int cols;
+
+        /** Cells of the level, row-major. */
+        const Connections* cells;
+
+        /** Jumpable bit of each cell, row-major (empty unless asked for). */
+        vector<unsigned char> jumpable;
+
+        /** Cost of entering a cell of each ConnectionCost (all 1 if unweighted). */
+        float costs[4];
+
+        /** Largest cost if every cost is a non-negative integer, -1 otherwise. */
+        int maxIntegerCost;
+
+        /** Vertex offset of the neighbor in each direction. */
+        int offsets[4];
+
+        /** Row and column offset of the neighbor in each direction. */
+        int deltas[4][2];
+
+        /** Returns true if the in level cell at row and col has an edge in direction k (see above). */
+        inline bool hasEdge(int vertex, int row, int col, int k) const {
+            if (!cells[vertex].hasDirection(k)) { return false; }
+            row += deltas[k][0];
+            col += deltas[k][1];
+            return row >= 0 && row < rows && col >= 0 && col < cols && cells[vertex + offsets[k]].inLevel;
+        }
+
+        public:
+
+        /** Default constructor (empty graph). */
+        GridGraph();
+
+        /** Views the given level (edges weighted by connection cost if flag is true), finding jumpable cells if jumps is true. */
+        GridGraph(const Level& level, bool flag, bool jumps = false);
+
+        /** Returns the outgoing edges of the vertex. */
+        inline GridEdgeRange getOutgoingEdges(int vertex) const {
+            GridEdgeRange edges(vertex);
+            if (!cells[vertex].inLevel) { return edges; }
+            int row = vertex / cols;
+            int col = vertex - row * cols;
+            for (int k = 0; k < 4; k++) {
+                if (!hasEdge(vertex, row, col, k)) { continue; }
+                int target = vertex + offsets[k];
+                edges.add(target, costs[cells[target].cost]);
+            }
+            return edges;
+        }
+
+        /** Returns the outgoing edges of the vertex. */
+        inline GridEdgeRange getOutgoingEdges(const Vertex& vertex) const { return getOutgoingEdges(vertex.getID()); }
+
+        /** Returns the node of the vertex. */
+        inline GraphNode getNode(const Vertex& vertex) const { return GraphNode(localize(vertex), vertex); }
+
+        /** Maps vertex in graph to location in level. */
+        inline Location localize(int vertex) const { return Location(vertex / cols, vertex % cols); }
+        inline Location localize(const Vertex& vertex) const { return localize(vertex.getID()); }
+
+        /** Returns the dense index of the location (assumes it is contained in the graph). */
+        inline int index(const Location& location) const { return location.x * cols + location.y; }
+
+        /** Maps location in level to GraphNode in graph. */
+        inline GraphNode quantize(const Location& location) const { return GraphNode(location, Vertex(index(location))); }
+
+        /** Returns true if the location is a tile of the graph. */
+        inline bool contains(const Location& location) const {
+            return location.x >= 0 && location.x < rows && location.y >= 0 && location.y < cols;
+        }
+
+        /** Returns true if the vertex's cell is in the level. */
+        inline bool inLevel(int vertex) const { return cells[vertex].inLevel; }
+
+        /** Returns true if the vertex's cell is a dead end (see above). */
+        bool isDeadEnd(int vertex) const;
+
+        /** Returns true if jumpable cells were asked for. */
+        inline bool hasJumpable() const { return !jumpable.empty(); }
+
+        /** Returns true if the vertex's cell is jumpable (see above; only if hasJumpable()). */
+        inline bool isJumpable(int vertex) const { return jumpable[vertex]; }
+
+        /** Returns true if the level allows any direction out of the vertex's cell. */
+        inline bool hasDirections(int vertex) const { return cells[vertex].directions != 0; }
+
+        /** Returns true if the vertex has an edge in direction k (index into Level::NEIGHBORS). */
+        inline bool hasEdge(int vertex, int k) const {
+            if (!cells[vertex].inLevel) { return false; }
+            int row = vertex / cols;
+            return hasEdge(vertex, row, vertex - row * cols, k);
+        }
+
+        /** Returns the vertex offset of the neighbor in direction k (index into Level::NEIGHBORS). */
+        inline int getOffset(int k) const { return offsets[k]; }
+
+        /** Returns the cost of every edge into the vertex. */
+        inline float getCost(int vertex) const { return costs[cells[vertex].cost]; }
+
+        /** Returns the cost of every edge into a uniform cell. */
+        inline float getUniformCost() const { return costs[normal]; }
+
+        /** Returns the number of vertices. */
+        inline int size() const { return rows * cols; }
+
+        /** Returns the largest edge cost if every cost is a non-negative integer, -1 otherwise. */
+        inline int getMaxIntegerCost() const { return maxIntegerCost; }
+
+        /** Returns the bytes of heap the graph holds (the level's cells are not its own). */
+        inline size_t getHeapBytes() const { return jumpable.capacity(); }
+
+        /** Getters. */
+        inline int getRows() const { return rows; }
+        inline int getCols() const { return cols; }
+    };
+};
+
+#endif
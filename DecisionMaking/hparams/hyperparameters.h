@@ -3,6 +3,7 @@
 
 #include <cmath>
 #include "../id/id.h"
+#include "../level/transform.h"
 
 const int ARGC = 2;
 
@@ -50,6 +51,27 @@ const float WANDER_MAX_ACCELERATION = 20.f;
 const float MAZE_X = 22.f;
 const float MAZE_Y = 22.f;
 const float SIZE = std::sqrt((SCENE_WINDOW_X * SCENE_WINDOW_Y) / (MAZE_X * MAZE_Y));
+const GridTransform GRID_TRANSFORM(MAZE_X, SIZE);
 const bool BREAD_CRUMBS = false;
 
+// Path tables (which answer every query on this level, leaving the searches below unused).
+const bool PATH_TABLES = false;
+const char* const PATH_TABLE_CACHE = ".";
+
+// Monsters chasing the character through a shared flow field (0 for the original one monster game).
+const int SWARM_MONSTERS = 0;
+
+// Search budget per frame, divided among searches in progress (0 microseconds for no time limit).
+const int SEARCH_EXPANSIONS_PER_FRAME = 500;
+const long long SEARCH_MICROSECONDS_PER_FRAME = 2000;
+
+// Threads searching requested paths in the background, started by the first request (0 to search on the main thread).
+const int PATH_SERVICE_THREADS = 1;
+
+// Path cache (locations stored across cached paths, 0 for none).
+const int PATH_CACHE_CAPACITY = 4096;
+
+// Quick searches (escapes, wandering) find paths costing at most this many times the shortest.
+const float SUBOPTIMALITY_BOUND = 2;
+
 #endif
\ No newline at end of file
@@ -12,7 +12,7 @@ using namespace sf;
 using namespace graph;
 
 
-enum ConnectionCost
+enum ConnectionCost : unsigned char
 {
     normal,
     pricey,
@@ -22,24 +22,94 @@ enum ConnectionCost
 
 float mapConnectionCost(ConnectionCost cost);
 
-/** Represents an edge in the level. */
+/** Represents an edge in the level. Packed into a single byte. */
 class Connections
 {
     public:
 
+    /** True if connection is within the level. */
+    bool inLevel : 1;
+
     /** Cost of a given connection. */
-    ConnectionCost cost = normal;
+    ConnectionCost cost : 2;
 
-    /** True if connection is within the level. */
-    bool inLevel = false;
+    /** Possible directions at a given time, one bit each (right, up, down, left). */
+    unsigned char directions : 4;
+
+    /** Default constructor (not in level, normal cost, no directions). */
+    inline Connections() : inLevel(false), cost(normal), directions(0) {}
 
-    /** Possible directions at a given time (right, up, down, left). */
-    bool directions[4] = { false, false, false, false };
+    /** Returns true if direction k (index into Level::NEIGHBORS) is possible. */
+    inline bool hasDirection(int k) const { return (directions >> k) & 1; }
+
+    /** Sets whether direction k (index into Level::NEIGHBORS) is possible. */
+    inline void setDirection(int k, bool possible) {
+        directions = possible ? (directions | (1 << k)) : (directions & ~(1 << k));
+    }
 
     void setFalse();
     void setTrue();
 };
 
+static_assert(sizeof(Connections) == 1, "Connections must pack into one byte");
+
+/** The cells of a level in one contiguous row-major block, indexed like a 2D array (cells[row][col]). */
+class CellGrid
+{
+    private:
+
+    /** Number of columns (row length). */
+    int cols;
+
+    /** Cells, row-major. */
+    vector<Connections> cells;
+
+    /** Number of writes to the cells. */
+    unsigned int revision;
+
+    /** Returns the cell for writing (setters count the write). */
+    inline Connections& cell(int row, int col) { return cells[row * cols + col]; }
+
+    public:
+
+    /** Default constructor (no cells). */
+    inline CellGrid() : cols(0), revision(0) {}
+
+    /** Constructs rows * cols default cells. */
+    inline CellGrid(int rows, int cols) : cols(cols), cells(rows * cols), revision(0) {}
+
+    /** Returns the first cell of the row, for reading (write through the setters). */
+    inline const Connections* operator[](int row) const { return cells.data() + row * cols; }
+
+    /** Setters, each counting as a change. */
+    inline void setInLevel(int row, int col, bool inLevel) {
+        cell(row, col).inLevel = inLevel;
+        revision++;
+    }
+    inline void setCost(int row, int col, ConnectionCost cost) {
+        cell(row, col).cost = cost;
+        revision++;
+    }
+    inline void setDirection(int row, int col, int k, bool possible) {
+        cell(row, col).setDirection(k, possible);
+        revision++;
+    }
+    inline void setDirections(int row, int col, bool possible) {
+        if (possible) { cell(row, col).setTrue(); }
+        else { cell(row, col).setFalse(); }
+        revision++;
+    }
+
+    /** Returns the cells, row-major, for reading. */
+    inline const Connections* data() const { return cells.data(); }
+
+    /** Returns the number of cells. */
+    inline int size() const { return cells.size(); }
+
+    /** Returns a number that changes whenever a cell is written. */
+    inline unsigned int getRevision() const { return revision; }
+};
+
 /** Represents cell in a Level. */
 class LevelCell : public RectangleShape
 {
@@ -84,8 +154,8 @@ class Level
     /** Number of columns of level. */
     int cols;
 
-    /** 2D grid representing level. */
-    vector<vector<Connections>> cells;
+    /** 2D grid representing level (one byte per cell). */
+    CellGrid cells;
 
     /** Initializes level with all its fields. */
     Level(int w, int h);
@@ -137,6 +207,9 @@ class Level
     /** Prints the level. */
     void print();
 
+    /** Returns a number that changes whenever a cost or connection is written. */
+    inline unsigned int getRevision() const { return cells.getRevision(); }
+
     /** Getters. */
     int getRows();
     int getCols();
@@ -148,7 +221,7 @@ Level generateMaze(int r, int c);
 /** Converts the given level into a graph and returns it.*/
 Graph levelToGraph(const Level& level);
 
-/** Converts the given level into a graph and returns it.*/
+/** Converts the given level into a graph and returns it (edges weighted by connection cost if flag is true).*/
 Graph levelToGraph(const Level& level, bool flag);
 
 /** Generates fixed size level. */
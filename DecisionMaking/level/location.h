@@ -13,7 +13,7 @@ class Location
     public:
 
     /** Constructs a location with all its fields. */
-    Location(int a, int b);
+    inline Location(int a, int b) : x(a), y(b) {}
 
     /** X coordinate in level. */
     int x;
@@ -43,15 +43,6 @@ namespace std {
     };
 }
 
-/** Returns mapping of position in SFML render window to location in graph. */
-Location mapToLevel(int dimension, float mappingScale, const Vector2f& vector);
-
-/** Returns mapping of location in graph to position in SFML render window. */
-Vector2f mapToWindow(float mappingScale, const Location& location);
-
-/** Returns Vector2f with x and y flipped. */
-Vector2f flip(const Vector2f& v);
-
 /** Returns direction from a to b. (1=left,2=up,3=right,4=down. */
 inline int getDirection(const Location& a, const Location& b) {
     // Asssume a and b are not same position.
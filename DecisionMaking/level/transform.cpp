@@ -0,0 +1,8 @@
+#include <SFML/Graphics.hpp>
+#include "location.h"
+#include "transform.h"
+
+using namespace std;
+using namespace sf;
+
+GridTransform::GridTransform(int dimension, float tileSize) : dimension(dimension), tileSize(tileSize) {}
@@ -0,0 +1,67 @@
+#ifndef TRANSFORM_H
+#define TRANSFORM_H
+
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include "location.h"
+
+using namespace std;
+using namespace sf;
+
+/**
+ * Maps between positions in the SFML render window and locations in a square tile level.
+ * Owns the tile size and the transpose convention: level rows run down the window, so
+ * location (x, y) is the tile whose window position is (y * tileSize, x * tileSize).
+ * A position on a tile border, or outside the level, maps to no location (-1, -1).
+ */
+class GridTransform
+{
+    private:
+
+    /** Number of tiles along each side of the level. */
+    int dimension;
+
+    /** Width (and height) of a tile in the window. */
+    float tileSize;
+
+    /** Returns the tile index along one axis of the window coordinate (-1 if none). */
+    inline int toTile(float coordinate) const {
+
+        // Window positions snap to whole pixels (offset by one) before the tile test.
+        float pixel = int(coordinate + 1);
+
+        // The tile is the quotient, give or take one for rounding; the tile test picks among them.
+        int guess = int(floor(pixel / tileSize));
+        int tile = -1;
+        for (int i = guess + 1; i >= guess - 1; i--) {
+            float min = i * tileSize;
+            float max = min + tileSize;
+            bool inside = i >= 0 && i < dimension && pixel > min && pixel < max;
+            tile = inside ? i : tile;
+        }
+        return tile;
+    }
+
+    public:
+
+    /** Constructs a transform for a dimension x dimension level of tiles tileSize wide. */
+    GridTransform(int dimension, float tileSize);
+
+    /** Returns the location of the tile at the window position (-1, -1 if none). O(1). */
+    inline Location toLevel(const Vector2f& position) const {
+        int row = toTile(position.y);
+        int col = toTile(position.x);
+        return (row == -1 || col == -1) ? Location(-1, -1) : Location(row, col);
+    }
+
+    /** Returns the window position (top left corner) of the location's tile. */
+    inline Vector2f toWindow(const Location& location) const {
+        return Vector2f(location.y * tileSize, location.x * tileSize);
+    }
+
+    /** Getters. */
+    inline int getDimension() const { return dimension; }
+    inline float getTileSize() const { return tileSize; }
+};
+
+#endif
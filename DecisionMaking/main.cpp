@@ -3,7 +3,7 @@
 #include "level/level.h"
 #include "visualizers/visualizer.h"
 
-int ID::count = 0;
+atomic<int> ID::count(0);
 Vector2f LevelCell::dims = Vector2f(SIZE, SIZE);
 
 int main() {
@@ -0,0 +1,136 @@
+#include <cmath>
+#include "../graph/graph.h"
+#include "../graph/gridgraph.h"
+#include "priorityqueue.h"
+#include "searchstate.h"
+#include "searchcontext.h"
+#include "search.h"
+#include "bidirectional.h"
+
+using namespace std;
+
+BidirectionalSearch::BidirectionalSearch(const GraphHandle& graph, const Location& start, const Location& end) :
+    Search(graph, start, end), toEnd(nullptr), toStart(nullptr) {}
+
+BidirectionalSearch::BidirectionalSearch(const GraphHandle& graph, const Location& start, const Location& end, const Heuristic& toEnd,
+    const Heuristic& toStart) : Search(graph, start, end), toEnd(&toEnd), toStart(&toStart) {}
+
+Path BidirectionalSearch::search() const {
+    Graph reverse = getGraph().transpose();
+    SearchContext forward(getGraph().size());
+    SearchContext backward(getGraph().size());
+    Path path;
+    run(getGraph(), reverse, getStart(), getEnd(), toEnd, toStart, forward, backward, path);
+    return path;
+}
+
+template <class G>
+void BidirectionalSearch::search(const G& graph, const Graph& reverse, const Location& start, const Location& end, SearchContext& forward,
+    SearchContext& backward, Path& path) {
+    run(graph, reverse, start, end, nullptr, nullptr, forward, backward, path);
+}
+
+template <class G>
+void BidirectionalSearch::search(const G& graph, const Graph& reverse, const Location& start, const Location& end, const Heuristic& toEnd,
+    const Heuristic& toStart, SearchContext& forward, SearchContext& backward, Path& path) {
+    run(graph, reverse, start, end, &toEnd, &toStart, forward, backward, path);
+}
+
+template <class H>
+void BidirectionalSearch::expand(const H& graph, SearchState& state, IndexedPriorityQueue& openList, const SearchState& other,
+    const Heuristic* toEnd, const Heuristic* toStart, float sign, float& best, int& meet) {
+    int current = openList.pop();
+    state.setState(current, GraphNodeRecordState::closed);
+    auto edges = graph.getOutgoingEdges(current);
+    float currentCSF = state.getCostSoFar(current);
+
+    for (int i = 0; i < edges.size(); i++) {
+        int endNode = edges.target(i);
+        float endNodeCSF = currentCSF + edges.cost(i);
+
+        // A vertex the other side has reached completes a path through this edge.
+        if (other.getState(endNode) != GraphNodeRecordState::unvisited && endNodeCSF + other.getCostSoFar(endNode) < best) {
+            best = endNodeCSF + other.getCostSoFar(endNode);
+            meet = endNode;
+        }
+
+        // Consistent potentials never reopen closed vertices.
+        GraphNodeRecordState endNodeState = state.getState(endNode);
+        if (endNodeState == GraphNodeRecordState::closed) { continue; }
+        if (endNodeState == GraphNodeRecordState::open && state.getCostSoFar(endNode) <= endNodeCSF) { continue; }
+        float key = endNodeCSF + sign * potential(graph, endNode, toEnd, toStart);
+        state.setCostSoFar(endNode, endNodeCSF);
+        state.setParent(endNode, current);
+        if (endNodeState == GraphNodeRecordState::open) { openList.decreaseKey(endNode, key); }
+        else {
+            state.setState(endNode, GraphNodeRecordState::open);
+            openList.push(endNode, key);
+        }
+    }
+}
+
+template <class G>
+void BidirectionalSearch::run(const G& graph, const Graph& reverse, const Location& start, const Location& end, const Heuristic* toEnd,
+    const Heuristic* toStart, SearchContext& forward, SearchContext& backward, Path& path) {
+    path.clear();
+
+    // Locations outside of the graph have no path, and a path to itself is start and end.
+    if (!graph.contains(start) || !graph.contains(end)) { return; }
+    int startVertex = graph.index(start);
+    int endVertex = graph.index(end);
+    if (startVertex == endVertex) {
+        path.add(start);
+        path.add(end);
+        return;
+    }
+
+    // Setup both sides (each with its own per-vertex state and open list).
+    forward.reset();
+    backward.reset();
+    SearchState& forwardState = forward.getState();
+    SearchState& backwardState = backward.getState();
+    IndexedPriorityQueue& forwardOpen = forward.getOpenList();
+    IndexedPriorityQueue& backwardOpen = backward.getOpenList();
+    forwardState.setCostSoFar(startVertex, 0);
+    forwardState.setState(startVertex, GraphNodeRecordState::open);
+    forwardOpen.push(startVertex, potential(graph, startVertex, toEnd, toStart));
+    backwardState.setCostSoFar(endVertex, 0);
+    backwardState.setState(endVertex, GraphNodeRecordState::open);
+    backwardOpen.push(endVertex, -potential(graph, endVertex, toEnd, toStart));
+    float best = INFINITY;
+    int meet = -1;
+    int closedCount = 0;
+
+    // Expand the smaller frontier until no path through either can beat the best one.
+    while (!forwardOpen.isEmpty() && !backwardOpen.isEmpty() && forwardOpen.topKey() + backwardOpen.topKey() < best) {
+        if (forwardOpen.size() <= backwardOpen.size()) {
+            expand(graph, forwardState, forwardOpen, backwardState, toEnd, toStart, 1, best, meet);
+        }
+        else {
+            expand(reverse, backwardState, backwardOpen, forwardState, toEnd, toStart, -1, best, meet);
+        }
+        closedCount++;
+    }
+    if (meet == -1) { return; }
+
+    // Forward parents lead from the meeting vertex back to start, backward parents on to end.
+    for (int vertex = meet; ; vertex = forwardState.getParent(vertex)) {
+        path.add(graph.localize(vertex));
+        if (vertex == startVertex) { break; }
+    }
+    path.reverse();
+    for (int vertex = meet; vertex != endVertex; ) {
+        vertex = backwardState.getParent(vertex);
+        path.add(graph.localize(vertex));
+    }
+    path.exploredNodes = closedCount;
+}
+
+template void BidirectionalSearch::search<Graph>(const Graph&, const Graph&, const Location&, const Location&, SearchContext&, SearchContext&,
+    Path&);
+template void BidirectionalSearch::search<GridGraph>(const GridGraph&, const Graph&, const Location&, const Location&, SearchContext&,
+    SearchContext&, Path&);
+template void BidirectionalSearch::search<Graph>(const Graph&, const Graph&, const Location&, const Location&, const Heuristic&,
+    const Heuristic&, SearchContext&, SearchContext&, Path&);
+template void BidirectionalSearch::search<GridGraph>(const GridGraph&, const Graph&, const Location&, const Location&, const Heuristic&,
+    const Heuristic&, SearchContext&, SearchContext&, Path&);
@@ -0,0 +1,55 @@
+#include <vector>
+#include "bucketqueue.h"
+
+using namespace std;
+
+BucketQueue::BucketQueue(int capacity, int maxCost) :
+    heads(maxCost + 1, -1), next(capacity, -1), previous(capacity, -1), keys(capacity, -1),
+    maxCost(maxCost), count(0), cursor(-1) {}
+
+void BucketQueue::link(int vertex) {
+    int& head = heads[keys[vertex] % heads.size()];
+    previous[vertex] = -1;
+    next[vertex] = head;
+    if (head != -1) { previous[head] = vertex; }
+    head = vertex;
+}
+
+void BucketQueue::unlink(int vertex) {
+    if (previous[vertex] != -1) { next[previous[vertex]] = next[vertex]; }
+    else { heads[keys[vertex] % heads.size()] = next[vertex]; }
+    if (next[vertex] != -1) { previous[next[vertex]] = previous[vertex]; }
+}
+
+void BucketQueue::push(int vertex, float key) {
+    if (cursor == -1) { cursor = int(key); }
+    keys[vertex] = int(key);
+    link(vertex);
+    count++;
+}
+
+void BucketQueue::decreaseKey(int vertex, float key) {
+    unlink(vertex);
+    keys[vertex] = int(key);
+    link(vertex);
+}
+
+int BucketQueue::pop() {
+    // Queued keys lie in [cursor, cursor + maxCost], so the first non-empty bucket holds the smallest.
+    while (heads[cursor % heads.size()] == -1) { cursor++; }
+    int vertex = heads[cursor % heads.size()];
+    unlink(vertex);
+    keys[vertex] = -1;
+    count--;
+    return vertex;
+}
+
+void BucketQueue::clear() {
+    cursor = -1;
+    if (count == 0) { return; }
+    for (auto& head : heads) {
+        for (int vertex = head; vertex != -1; vertex = next[vertex]) { keys[vertex] = -1; }
+        head = -1;
+    }
+    count = 0;
+}
@@ -0,0 +1,79 @@
+#ifndef BUCKET_QUEUE_H
+#define BUCKET_QUEUE_H
+
+#include <vector>
+
+using namespace std;
+
+/**
+ * Circular bucket queue (Dial's algorithm) of graph vertices keyed by integer priorities.
+ * Meant for Dijkstra on graphs whose edge costs are integers in [0, maxCost]: every queued
+ * key then lies in [min, min + maxCost], so maxCost + 1 buckets indexed by key modulo their
+ * count suffice. Buckets are intrusive doubly linked lists over the vertices, so push() and
+ * decreaseKey() are O(1) and pop() is O(1) amortized (the cursor never moves backwards).
+ */
+class BucketQueue
+{
+    private:
+
+    /** First vertex of each bucket (-1 if empty). */
+    vector<int> heads;
+
+    /** Next and previous vertex in the bucket of each queued vertex (-1 for none). */
+    vector<int> next;
+    vector<int> previous;
+
+    /** Key of each vertex (-1 if not queued). */
+    vector<int> keys;
+
+    /** Largest edge cost (the largest key minus the smallest). */
+    int maxCost;
+
+    /** Number of queued vertices. */
+    int count;
+
+    /** Smallest key that may be queued (-1 until the first push after clearing). */
+    int cursor;
+
+    /** Links a vertex at the front of the bucket of its key. */
+    void link(int vertex);
+
+    /** Removes a vertex from the bucket of its key. */
+    void unlink(int vertex);
+
+    public:
+
+    /** Constructs an empty queue for vertices in [0, capacity) and edge costs in [0, maxCost]. */
+    BucketQueue(int capacity, int maxCost);
+
+    /** Returns true if the vertex is queued. */
+    inline bool contains(int vertex) const { return keys[vertex] != -1; }
+
+    /** Returns the priority of a queued vertex. */
+    inline float getKey(int vertex) const { return keys[vertex]; }
+
+    /** Getters. */
+    inline int size() const { return count; }
+    inline bool isEmpty() const { return count == 0; }
+    inline int getCapacity() const { return keys.size(); }
+    inline int getMaxCost() const { return maxCost; }
+
+    /** Returns the bytes of heap the queue holds. */
+    inline size_t getHeapBytes() const {
+        return (heads.capacity() + next.capacity() + previous.capacity() + keys.capacity()) * sizeof(int);
+    }
+
+    /** Queues a vertex that is not queued yet (an integer key in [last popped, last popped + maxCost]). */
+    void push(int vertex, float key);
+
+    /** Lowers the priority of a queued vertex. */
+    void decreaseKey(int vertex, float key);
+
+    /** Removes and returns a vertex with the smallest priority. */
+    int pop();
+
+    /** Removes every queued vertex (O(size + maxCost), not O(capacity)). */
+    void clear();
+};
+
+#endif
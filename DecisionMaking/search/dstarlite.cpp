@@ -0,0 +1,219 @@
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "../graph/graph.h"
+#include "search.h"
+#include "dstarlite.h"
+
+using namespace std;
+
+DStarLite::KeyQueue::KeyQueue(int capacity) : position(capacity, -1) {}
+
+void DStarLite::KeyQueue::siftUp(int i) {
+    Entry entry = heap[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!(entry.key < heap[parent].key)) { break; }
+        heap[i] = heap[parent];
+        position[heap[i].vertex] = i;
+        i = parent;
+    }
+    heap[i] = entry;
+    position[entry.vertex] = i;
+}
+
+void DStarLite::KeyQueue::siftDown(int i) {
+    Entry entry = heap[i];
+    int size = heap.size();
+    while (true) {
+        int child = 2 * i + 1;
+        if (child >= size) { break; }
+        if (child + 1 < size && heap[child + 1].key < heap[child].key) { child++; }
+        if (!(heap[child].key < entry.key)) { break; }
+        heap[i] = heap[child];
+        position[heap[i].vertex] = i;
+        i = child;
+    }
+    heap[i] = entry;
+    position[entry.vertex] = i;
+}
+
+void DStarLite::KeyQueue::push(int vertex, const Key& key) {
+    heap.push_back(Entry{ key, vertex });
+    siftUp(heap.size() - 1);
+}
+
+void DStarLite::KeyQueue::update(int vertex, const Key& key) {
+    int i = position[vertex];
+    heap[i].key = key;
+    siftUp(i);
+    siftDown(position[vertex]);
+}
+
+void DStarLite::KeyQueue::remove(int vertex) {
+    int i = position[vertex];
+    position[vertex] = -1;
+    Entry last = heap.back();
+    heap.pop_back();
+    if (i == (int)heap.size()) { return; }
+
+    // Put the last entry in the hole and restore the heap from there.
+    heap[i] = last;
+    position[last.vertex] = i;
+    siftUp(i);
+    siftDown(position[last.vertex]);
+}
+
+void DStarLite::KeyQueue::clear() {
+    for (const auto& entry : heap) { position[entry.vertex] = -1; }
+    heap.clear();
+}
+
+DStarLite::DStarLite(const GraphHandle& graph) :
+    graph(graph), reverse(graph->transpose()), g(graph->size(), INFINITY), rhs(graph->size(), INFINITY),
+    openList(graph->size()), goal(-1), start(-1), km(0) {}
+
+void DStarLite::reset() {
+    fill(g.begin(), g.end(), INFINITY);
+    fill(rhs.begin(), rhs.end(), INFINITY);
+    openList.clear();
+    goal = -1;
+    start = -1;
+    km = 0;
+}
+
+float DStarLite::lookahead(int vertex) const {
+    float best = INFINITY;
+    auto edges = graph->getOutgoingEdges(vertex);
+    for (int i = 0; i < edges.size(); i++) { best = min(best, edges.cost(i) + g[edges.target(i)]); }
+    return best;
+}
+
+void DStarLite::updateVertex(int vertex) {
+    bool queued = openList.contains(vertex);
+    if (g[vertex] != rhs[vertex]) {
+        if (queued) { openList.update(vertex, calculateKey(vertex)); }
+        else { openList.push(vertex, calculateKey(vertex)); }
+    }
+    else if (queued) {
+        openList.remove(vertex);
+    }
+}
+
+int DStarLite::computeShortestPath() {
+    int expanded = 0;
+    while (openList.topKey() < calculateKey(start) || rhs[start] > g[start]) {
+        int current = openList.top();
+        Key oldKey = openList.topKey();
+        Key newKey = calculateKey(current);
+
+        // Keyed before the start moved: queue again with its current key.
+        if (oldKey < newKey) {
+            openList.update(current, newKey);
+            continue;
+        }
+
+        auto predecessors = reverse.getOutgoingEdges(current);
+        expanded++;
+
+        // Overconsistent: its cost to the goal dropped, which may lower its predecessors'.
+        if (g[current] > rhs[current]) {
+            g[current] = rhs[current];
+            openList.remove(current);
+            for (int i = 0; i < predecessors.size(); i++) {
+                int predecessor = predecessors.target(i);
+                if (predecessor == goal) { continue; }
+                rhs[predecessor] = min(rhs[predecessor], predecessors.cost(i) + g[current]);
+                updateVertex(predecessor);
+            }
+            continue;
+        }
+
+        // Underconsistent: its cost to the goal rose, so predecessors that went through it look again.
+        float oldCost = g[current];
+        g[current] = INFINITY;
+        for (int i = 0; i < predecessors.size(); i++) {
+            int predecessor = predecessors.target(i);
+            if (predecessor == goal || rhs[predecessor] != predecessors.cost(i) + oldCost) { continue; }
+            rhs[predecessor] = lookahead(predecessor);
+            updateVertex(predecessor);
+        }
+        if (current != goal) { rhs[current] = lookahead(current); }
+        updateVertex(current);
+    }
+    return expanded;
+}
+
+void DStarLite::plan(const Location& start_, const Location& goal_, Path& path) {
+    path.clear();
+
+    // Locations outside of the graph have no path.
+    if (!graph->contains(start_) || !graph->contains(goal_)) { return; }
+    int newStart = graph->index(start_);
+    int newGoal = graph->index(goal_);
+
+    // First plan: the goal is the only vertex with a known cost.
+    if (goal == -1) {
+        start = newStart;
+        goal = newGoal;
+        rhs[goal] = 0;
+        updateVertex(goal);
+    }
+
+    // The start moved: shift new keys by how far it moved rather than re-keying the queue.
+    if (newStart != start) {
+        km += heuristic(start, newStart);
+        start = newStart;
+    }
+
+    // The goal moved: the old goal costs what its edges say, the new one costs nothing.
+    if (newGoal != goal) {
+        int oldGoal = goal;
+        goal = newGoal;
+        rhs[oldGoal] = lookahead(oldGoal);
+        updateVertex(oldGoal);
+        rhs[goal] = 0;
+        updateVertex(goal);
+    }
+    int expanded = computeShortestPath();
+
+    // Walk down the tree from the start, each step to the successor on a shortest path (a path to itself is start and goal).
+    // The start itself may be left overconsistent, but its lookahead is its cost.
+    if (rhs[start] == INFINITY) { return; }
+    int current = start;
+    if (start == goal) { path.add(graph->localize(goal)); }
+    path.add(graph->localize(current));
+    for (int steps = 0; current != goal && steps < graph->size(); steps++) {
+        auto edges = graph->getOutgoingEdges(current);
+        int next = -1;
+        float best = INFINITY;
+        for (int i = 0; i < edges.size(); i++) {
+            float cost = edges.cost(i) + g[edges.target(i)];
+            if (cost < best) {
+                best = cost;
+                next = edges.target(i);
+            }
+        }
+        if (next == -1) {
+            path.clear();
+            return;
+        }
+        current = next;
+        path.add(graph->localize(current));
+    }
+    if (current != goal) { path.clear(); }
+    path.exploredNodes = expanded;
+}
+
+void DStarLite::setGraph(const GraphHandle& graph_, const vector<int>& changed) {
+    graph = graph_;
+    reverse = graph->transpose();
+    if (goal == -1) { return; }
+
+    // Only the lookahead of a vertex whose outgoing edges changed can change.
+    for (int vertex : changed) {
+        if (vertex == goal) { continue; }
+        rhs[vertex] = lookahead(vertex);
+        updateVertex(vertex);
+    }
+}
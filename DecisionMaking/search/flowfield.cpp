@@ -0,0 +1,68 @@
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "../graph/graph.h"
+#include "priorityqueue.h"
+#include "search.h"
+#include "flowfield.h"
+
+using namespace std;
+
+FlowField::FlowField(const GraphHandle& graph) :
+    graph(graph), reverse(graph->transpose()), cost(graph->size(), INFINITY), offset(0), next(graph->size(), -1),
+    openList(graph->size()), goal(-1) {}
+
+int FlowField::improve() {
+    int expanded = 0;
+
+    // Dijkstra's algorithm over the reversed edges, keeping only cheaper costs.
+    while (!openList.isEmpty()) {
+        int current = openList.pop();
+        float currentCost = cost[current] + offset;
+        expanded++;
+        auto predecessors = reverse.getOutgoingEdges(current);
+        for (int i = 0; i < predecessors.size(); i++) {
+            int predecessor = predecessors.target(i);
+            float through = currentCost + predecessors.cost(i);
+            if (through >= cost[predecessor] + offset) { continue; }
+            cost[predecessor] = through - offset;
+            next[predecessor] = current;
+            if (openList.contains(predecessor)) { openList.decreaseKey(predecessor, through); }
+            else { openList.push(predecessor, through); }
+        }
+    }
+    return expanded;
+}
+
+int FlowField::setGoal(const Location& goal_) {
+    if (!contains(goal_)) { return 0; }
+    int newGoal = graph->index(goal_);
+    if (newGoal == goal) { return 0; }
+
+    // Find the edge from the last goal to the new one, if any.
+    float step = INFINITY;
+    if (goal != -1) {
+        auto edges = graph->getOutgoingEdges(goal);
+        for (int i = 0; i < edges.size(); i++) {
+            if (edges.target(i) == newGoal) { step = min(step, edges.cost(i)); }
+        }
+    }
+
+    // Next to the last goal: every path to it extends by the step to the new goal.
+    if (step != INFINITY) {
+        offset += step;
+        next[goal] = newGoal;
+    }
+
+    // Otherwise start over.
+    else {
+        fill(cost.begin(), cost.end(), INFINITY);
+        fill(next.begin(), next.end(), -1);
+        offset = 0;
+    }
+    goal = newGoal;
+    cost[goal] = -offset;
+    next[goal] = -1;
+    openList.push(goal, 0);
+    return improve();
+}
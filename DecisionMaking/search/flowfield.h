@@ -0,0 +1,81 @@
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include <vector>
+#include <cmath>
+#include "../graph/graph.h"
+#include "priorityqueue.h"
+#include "search.h"
+
+using namespace std;
+
+/**
+ * Flow field (Dijkstra map) towards one goal: every vertex's cost to the goal and the next
+ * vertex on a shortest path there, from one Dijkstra search from the goal over the reversed
+ * graph. Any number of agents then steer by lookup instead of searching each.
+ *
+ * When the goal steps along an edge to a neighbor the field is repaired instead: heading to
+ * the old goal and taking that edge costs every vertex its old cost plus the edge's, which is
+ * added in O(1) as an offset to all stored costs. A Dijkstra search from the new goal then only
+ * expands the vertices with a cheaper path than that, as those on it all have one too.
+ */
+class FlowField
+{
+    private:
+
+    /** Graph the field covers and its transpose (for the predecessors of a vertex). */
+    GraphHandle graph;
+    Graph reverse;
+
+    /** Cost to the goal of each vertex, less the offset. */
+    vector<float> cost;
+    float offset;
+
+    /** Next vertex towards the goal of each vertex (-1 for the goal and cut off vertices). */
+    vector<int> next;
+
+    /** Vertices to expand, keyed by cost to the goal. */
+    IndexedPriorityQueue openList;
+
+    /** Goal vertex (-1 before the first). */
+    int goal;
+
+    /** Expands queued vertices, lowering their predecessors' costs, returning the vertices expanded. */
+    int improve();
+
+    public:
+
+    /** Constructs a field on graph without a goal. */
+    FlowField(const GraphHandle& graph);
+
+    /**
+     * Points the field at goal, repairing it when goal is at the end of an edge from the last
+     * goal and computing it from scratch otherwise. Returns the number of vertices expanded.
+     */
+    int setGoal(const Location& goal);
+
+    /** Returns true if the location is a vertex of the field's graph. */
+    inline bool contains(const Location& location) const { return graph->contains(location); }
+
+    /** Returns the location's cost to the goal (infinity if cut off or outside of the graph). */
+    inline float getCost(const Location& location) const {
+        return contains(location) ? cost[graph->index(location)] + offset : INFINITY;
+    }
+
+    /**
+     * Returns the location to head to from location: the next on a shortest path to the goal,
+     * the goal itself at the goal, and (-1, -1) if there is none.
+     */
+    inline Location getNext(const Location& location) const {
+        if (goal == -1 || !contains(location)) { return Location(-1, -1); }
+        int vertex = graph->index(location);
+        if (vertex == goal) { return location; }
+        return next[vertex] == -1 ? Location(-1, -1) : graph->localize(next[vertex]);
+    }
+
+    /** Getters. */
+    inline Location getGoal() const { return goal == -1 ? Location(-1, -1) : graph->localize(goal); }
+    inline int size() const { return cost.size(); }
+};
+
+#endif
@@ -0,0 +1,120 @@
+#include <vector>
+#include "../graph/graph.h"
+#include "../graph/gridgraph.h"
+#include "searchstate.h"
+#include "searchcontext.h"
+#include "search.h"
+#include "a*.h"
+#include "clustergraph.h"
+#include "hpa.h"
+
+using namespace std;
+
+AbstractQueryGraph::AbstractQueryGraph(const ClusterGraph& clusters, int startVertex, int endVertex, const vector<int>& startTargets,
+    const vector<float>& startCosts, const vector<float>& goalCosts, float directCost) :
+    clusters(&clusters), startVertex(startVertex), endVertex(endVertex), startTargets(&startTargets), startCosts(&startCosts),
+    goalCosts(&goalCosts), directCost(directCost) {}
+
+AbstractHeuristic::AbstractHeuristic(const Heuristic& heuristic) : Heuristic(heuristic.getGoalLocation()), heuristic(&heuristic) {}
+
+float AbstractHeuristic::compute(const Location& location) const {
+    return heuristic->compute(location) * (1 + TIE_BREAK);
+}
+
+HierarchicalContext::HierarchicalContext(const ClusterGraph& clusters) :
+    gridContext(clusters.getGrid().size()), abstractContext(clusters.size() + 2) {}
+
+void HierarchicalSearch::search(const ClusterGraph& clusters, const Location& start, const Location& end, const Heuristic& heuristic,
+    HierarchicalContext& context, HierarchicalPath& plan) {
+    plan.clear();
+
+    // Locations outside of the graph have no path.
+    const GridGraph& grid = clusters.getGrid();
+    if (!grid.contains(start) || !grid.contains(end)) { return; }
+
+    // A path to itself is start and end.
+    int startVertex = grid.index(start);
+    int endVertex = grid.index(end);
+    if (startVertex == endVertex) {
+        plan.addWaypoint(startVertex);
+        plan.addWaypoint(endVertex);
+        plan.addRefined();
+        plan.getPath().add(start);
+        plan.getPath().add(end);
+        return;
+    }
+
+    // Nearby goals are searched on the grid directly: the abstract path would have to turn at
+    // transitions, which costs the most relative to short paths.
+    if (clusters.isAdjacent(clusters.getCluster(startVertex), clusters.getCluster(endVertex))) {
+        Path& path = plan.getPath();
+        AStar::search(grid, start, end, heuristic, context.getGridContext(), path);
+        if (path.isEmpty()) { return; }
+        plan.addWaypoint(startVertex);
+        plan.addWaypoint(endVertex);
+        plan.addRefined();
+        return;
+    }
+
+    // Link the start to the nodes of its cluster (and to the goal if it is in the same cluster).
+    SearchContext& gridContext = context.getGridContext();
+    SearchState& state = gridContext.getState();
+    int explored = clusters.searchCluster(startVertex, -1, false, gridContext);
+    int startCluster = clusters.getCluster(startVertex);
+    context.getStartTargets().clear();
+    context.getStartCosts().clear();
+    for (int node = clusters.getClusterBegin(startCluster); node < clusters.getClusterEnd(startCluster); node++) {
+        if (state.getState(clusters.getVertex(node)) != GraphNodeRecordState::closed) { continue; }
+        context.getStartTargets().push_back(node);
+        context.getStartCosts().push_back(state.getCostSoFar(clusters.getVertex(node)));
+    }
+    float directCost = -1;
+    if (clusters.getCluster(endVertex) == startCluster && state.getState(endVertex) == GraphNodeRecordState::closed) {
+        directCost = state.getCostSoFar(endVertex);
+    }
+
+    // Link the nodes of the goal's cluster to the goal.
+    explored += clusters.searchCluster(endVertex, -1, true, gridContext);
+    int endCluster = clusters.getCluster(endVertex);
+    context.getGoalCosts().clear();
+    for (int node = clusters.getClusterBegin(endCluster); node < clusters.getClusterEnd(endCluster); node++) {
+        bool reaches = state.getState(clusters.getVertex(node)) == GraphNodeRecordState::closed;
+        context.getGoalCosts().push_back(reaches ? state.getCostSoFar(clusters.getVertex(node)) : -1);
+    }
+
+    // Search the abstract graph.
+    AbstractQueryGraph query(clusters, startVertex, endVertex, context.getStartTargets(), context.getStartCosts(),
+        context.getGoalCosts(), directCost);
+    Path& waypointPath = context.getWaypointPath();
+    AStar::search(query, start, end, AbstractHeuristic(heuristic), context.getAbstractContext(), waypointPath);
+    if (waypointPath.isEmpty()) { return; }
+
+    // The path starts at start and is refined from there.
+    for (const auto& location : waypointPath.getPathList()) { plan.addWaypoint(grid.index(location)); }
+    plan.getPath().add(start);
+    plan.getPath().exploredNodes = waypointPath.exploredNodes + explored;
+}
+
+bool HierarchicalSearch::refine(const ClusterGraph& clusters, HierarchicalContext& context, HierarchicalPath& plan, int count) {
+    const GridGraph& grid = clusters.getGrid();
+    Path& path = plan.getPath();
+    for (int i = 0; i < count && !plan.isComplete(); i++) {
+        int from = plan.getWaypoints()[plan.getRefined()];
+        int to = plan.getWaypoints()[plan.getRefined() + 1];
+
+        // Waypoints in different clusters are the two cells of a transition.
+        if (clusters.getCluster(from) != clusters.getCluster(to)) { path.add(grid.localize(to)); }
+
+        // Otherwise search the cluster and add its cells after from.
+        else if (from != to) {
+            path.exploredNodes += clusters.searchCluster(from, to, false, context.getGridContext());
+            const SearchState& state = context.getGridContext().getState();
+            vector<int>& segment = context.getSegment();
+            segment.clear();
+            for (int vertex = to; vertex != from; vertex = state.getParent(vertex)) { segment.push_back(vertex); }
+            for (int j = segment.size() - 1; j >= 0; j--) { path.add(grid.localize(segment[j])); }
+        }
+        plan.addRefined();
+    }
+    return plan.isComplete();
+}
@@ -0,0 +1,118 @@
+#include <vector>
+#include <cmath>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include "../graph/graph.h"
+#include "../graph/gridgraph.h"
+#include "priorityqueue.h"
+#include "search.h"
+#include "landmarks.h"
+
+using namespace std;
+
+/** Fills costSoFar with the cost from source to every vertex of graph (INFINITY if unreachable). */
+template <class G>
+static void singleSource(const G& graph, int source, IndexedPriorityQueue& openList, vector<float>& costSoFar) {
+    fill(costSoFar.begin(), costSoFar.end(), INFINITY);
+    costSoFar[source] = 0;
+    openList.push(source, 0);
+    while (!openList.isEmpty()) {
+        int current = openList.pop();
+        auto edges = graph.getOutgoingEdges(current);
+        for (int i = 0; i < edges.size(); i++) {
+            int target = edges.target(i);
+            float targetCSF = costSoFar[current] + edges.cost(i);
+            if (targetCSF >= costSoFar[target]) { continue; }
+            costSoFar[target] = targetCSF;
+            if (openList.contains(target)) { openList.decreaseKey(target, targetCSF); }
+            else { openList.push(target, targetCSF); }
+        }
+    }
+}
+
+template <class G>
+Landmarks::Landmarks(const G& graph, int count, int threads) : rows(graph.getRows()), cols(graph.getCols()) {
+    IndexedPriorityQueue openList(graph.size());
+    vector<float> costSoFar(graph.size());
+
+    // Farthest-point selection, seeded by the vertex farthest from the first one with edges.
+    int seed = 0;
+    while (seed < graph.size() && graph.getOutgoingEdges(seed).isEmpty()) { seed++; }
+    if (seed == graph.size()) { return; }
+    singleSource(graph, seed, openList, costSoFar);
+    vector<float> nearest(costSoFar);
+    for (int i = 0; i < count; i++) {
+
+        // The next landmark is the reachable vertex farthest from its nearest landmark (or the seed), one that leads somewhere.
+        int farthest = -1;
+        for (int vertex = 0; vertex < graph.size(); vertex++) {
+            if (nearest[vertex] == INFINITY || (farthest != -1 && nearest[vertex] <= nearest[farthest])) { continue; }
+            if (graph.getOutgoingEdges(vertex).isEmpty()) { continue; }
+            farthest = vertex;
+        }
+        if (farthest == -1 || (i > 0 && nearest[farthest] == 0)) { break; }
+        landmarks.push_back(farthest);
+        singleSource(graph, farthest, openList, costSoFar);
+        for (int vertex = 0; vertex < graph.size(); vertex++) {
+            nearest[vertex] = i == 0 ? costSoFar[vertex] : min(nearest[vertex], costSoFar[vertex]);
+        }
+    }
+
+    // Costs from landmarks search the graph, costs to them search its transpose, one landmark per thread at a time.
+    fromLandmarks.assign(graph.size() * landmarks.size(), INFINITY);
+    toLandmarks.assign(graph.size() * landmarks.size(), INFINITY);
+    Graph transpose = Graph::transpose(graph);
+    if (threads <= 0) { threads = max(1u, thread::hardware_concurrency()); }
+    atomic<int> nextFrom(0);
+    atomic<int> nextTo(0);
+    vector<thread> workers;
+    for (int i = 1; i < threads; i++) {
+        workers.push_back(thread([&]() {
+            fillDistances(graph, &nextFrom, fromLandmarks);
+            fillDistances(transpose, &nextTo, toLandmarks);
+        }));
+    }
+    fillDistances(graph, &nextFrom, fromLandmarks);
+    fillDistances(transpose, &nextTo, toLandmarks);
+    for (auto& worker : workers) { worker.join(); }
+}
+
+template <class G>
+void Landmarks::fillDistances(const G& graph, atomic<int>* next, vector<float>& distances) const {
+    IndexedPriorityQueue openList(graph.size());
+    vector<float> costSoFar(graph.size());
+    int count = landmarks.size();
+    for (int i = next->fetch_add(1); i < count; i = next->fetch_add(1)) {
+        singleSource(graph, landmarks[i], openList, costSoFar);
+
+        // Each landmark owns its own column, so threads never write the same entry.
+        for (int vertex = 0; vertex < graph.size(); vertex++) { distances[vertex * count + i] = costSoFar[vertex]; }
+    }
+}
+
+float Landmarks::getBound(int from, int to) const {
+    float bound = 0;
+    for (int i = 0; i < size(); i++) {
+
+        // Unreachable terms bound nothing (a difference of infinities is not a cost).
+        float fromTo = getCostFrom(i, to);
+        float fromFrom = getCostFrom(i, from);
+        if (fromTo != INFINITY && fromFrom != INFINITY) { bound = max(bound, fromTo - fromFrom); }
+        float toFrom = getCostTo(i, from);
+        float toTo = getCostTo(i, to);
+        if (toFrom != INFINITY && toTo != INFINITY) { bound = max(bound, toFrom - toTo); }
+    }
+    return bound;
+}
+
+template Landmarks::Landmarks<Graph>(const Graph&, int, int);
+template Landmarks::Landmarks<GridGraph>(const GridGraph&, int, int);
+
+LandmarkHeuristic::LandmarkHeuristic(const Landmarks& landmarks, const Location& goal) :
+    Heuristic(goal), landmarks(&landmarks), goal(landmarks.contains(goal) ? landmarks.index(goal) : -1) {}
+
+float LandmarkHeuristic::compute(const Location& location) const {
+    if (goal == -1 || !landmarks->contains(location)) { return 0; }
+    return landmarks->getBound(landmarks->index(location), goal);
+}
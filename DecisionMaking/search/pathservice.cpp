@@ -0,0 +1,72 @@
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include "../graph/graph.h"
+#include "searchcontext.h"
+#include "search.h"
+#include "a*.h"
+#include "dijsktra.h"
+#include "pathservice.h"
+
+using namespace std;
+using namespace std::chrono;
+
+PathService::PathService(const GraphHandle& graph, int threads) :
+    graph(graph), threads(threads > 0 ? threads : max(1u, thread::hardware_concurrency())), stopping(false) {}
+
+PathService::~PathService() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    queued.notify_all();
+    for (auto& worker : workers) { worker.join(); }
+}
+
+shared_ptr<PathTicket> PathService::request(const Location& start, const Location& end, const shared_ptr<const Heuristic>& heuristic) {
+    auto ticket = make_shared<PathTicket>(start, end, heuristic);
+    {
+        lock_guard<mutex> guard(lock);
+        if (workers.empty()) {
+            for (int i = 0; i < threads; i++) { workers.push_back(thread(&PathService::work, this)); }
+        }
+        requests.push_back(ticket);
+    }
+    queued.notify_one();
+    return ticket;
+}
+
+int PathService::getQueued() {
+    lock_guard<mutex> guard(lock);
+    return requests.size();
+}
+
+void PathService::work() {
+    const Graph& graph = *this->graph;
+    SearchContext context(graph.size());
+    while (true) {
+        shared_ptr<PathTicket> ticket;
+        {
+            unique_lock<mutex> guard(lock);
+            queued.wait(guard, [this]() { return stopping || !requests.empty(); });
+            if (stopping) { return; }
+            ticket = move(requests.front());
+            requests.pop_front();
+        }
+
+        // Requests cancelled while queued are never searched.
+        if (!ticket->isPending()) { continue; }
+        auto startTime = steady_clock::now();
+        if (ticket->heuristic != nullptr) { AStar::search(graph, ticket->start, ticket->end, *ticket->heuristic, context, ticket->path); }
+        else { Dijkstra::search(graph, ticket->start, ticket->end, context, ticket->path); }
+        ticket->microseconds = duration_cast<microseconds>(steady_clock::now() - startTime).count();
+
+        // Publish the path, unless the request was cancelled meanwhile.
+        int expected = PATH_PENDING;
+        ticket->status.compare_exchange_strong(expected, PATH_READY, memory_order_release, memory_order_relaxed);
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef PATH_SERVICE_H
+#define PATH_SERVICE_H
+
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include "../graph/graph.h"
+#include "search.h"
+
+using namespace std;
+
+/** Progress of an asynchronous path request. */
+enum PathRequestStatus
+{
+    PATH_PENDING,
+    PATH_READY,
+    PATH_CANCELLED
+};
+
+/**
+ * Ticket of one request to a PathService, shared by the requester and the service. The path is
+ * written by a worker before the ticket turns ready and never after, so it may be read without
+ * locking once isReady() returns true. A cancelled ticket is skipped or its result dropped.
+ */
+class PathTicket
+{
+    friend class PathService;
+
+    private:
+
+    /** Query: A* from start to end guided by heuristic, or Dijkstra if it is null. */
+    Location start;
+    Location end;
+    shared_ptr<const Heuristic> heuristic;
+
+    /** PathRequestStatus of the request. */
+    atomic<int> status;
+
+    /** Path found (valid once ready), and the time spent searching it. */
+    Path path;
+    long long microseconds;
+
+    public:
+
+    /** Constructs a pending ticket for the query. */
+    inline PathTicket(const Location& start, const Location& end, const shared_ptr<const Heuristic>& heuristic) :
+        start(start), end(end), heuristic(heuristic), status(PATH_PENDING), microseconds(0) {}
+
+    /** Cancels the request unless its path is ready. */
+    inline void cancel() {
+        int expected = PATH_PENDING;
+        status.compare_exchange_strong(expected, PATH_CANCELLED);
+    }
+
+    /** Getters (the path and time only once ready). */
+    inline PathRequestStatus getStatus() const { return PathRequestStatus(status.load(memory_order_acquire)); }
+    inline bool isReady() const { return getStatus() == PATH_READY; }
+    inline bool isPending() const { return getStatus() == PATH_PENDING; }
+    inline const Path& getPath() const { return path; }
+    inline long long getMicroseconds() const { return microseconds; }
+    inline const Location& getStart() const { return start; }
+    inline const Location& getEnd() const { return end; }
+};
+
+/**
+ * Background worker threads answering path requests on one shared graph, in the order they are
+ * submitted. The workers start with the first request, so an unused service costs no thread. Requesting only queues a ticket, so callers never block on a search; they poll the
+ * ticket (e.g. once per frame) and keep steering along their current path until it is ready.
+ * Each worker owns its search context, as in SearchPool.
+ */
+class PathService
+{
+    private:
+
+    /** The graph every request runs on. */
+    GraphHandle graph;
+
+    /** Number of workers, and the worker threads (started by the first request). */
+    int threads;
+    vector<thread> workers;
+
+    /** Guards the queue and stopping. */
+    mutex lock;
+    condition_variable queued;
+
+    /** Requests not yet taken by a worker, and whether the service is shutting down. */
+    deque<shared_ptr<PathTicket>> requests;
+    bool stopping;
+
+    /** Answers requests until the service is destroyed. */
+    void work();
+
+    public:
+
+    /** Constructs a service of the given number of workers on graph (0 for one per hardware thread). */
+    PathService(const GraphHandle& graph, int threads = 0);
+
+    /** Stops and joins the workers (requests still queued stay pending). */
+    ~PathService();
+
+    /** Queues a request for the path from start to end (Dijkstra if heuristic is null) and returns its ticket. */
+    shared_ptr<PathTicket> request(const Location& start, const Location& end, const shared_ptr<const Heuristic>& heuristic);
+
+    /** Returns the number of requests not yet taken by a worker. */
+    int getQueued();
+
+    /** Getters. */
+    inline int getThreadCount() const { return threads; }
+    inline const Graph& getGraph() const { return *graph; }
+};
+
+#endif
@@ -0,0 +1,66 @@
+#include <vector>
+#include "priorityqueue.h"
+
+using namespace std;
+
+IndexedPriorityQueue::IndexedPriorityQueue(int capacity) : position(capacity, -1) {}
+
+void IndexedPriorityQueue::siftUp(int i) {
+    Entry entry = heap[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (heap[parent].key <= entry.key) { break; }
+        heap[i] = heap[parent];
+        position[heap[i].vertex] = i;
+        i = parent;
+    }
+    heap[i] = entry;
+    position[entry.vertex] = i;
+}
+
+void IndexedPriorityQueue::siftDown(int i) {
+    Entry entry = heap[i];
+    int n = heap.size();
+    while (true) {
+        int child = 2 * i + 1;
+        if (child >= n) { break; }
+        if (child + 1 < n && heap[child + 1].key < heap[child].key) { child++; }
+        if (entry.key <= heap[child].key) { break; }
+        heap[i] = heap[child];
+        position[heap[i].vertex] = i;
+        i = child;
+    }
+    heap[i] = entry;
+    position[entry.vertex] = i;
+}
+
+void IndexedPriorityQueue::push(int vertex, float key) {
+    Entry entry;
+    entry.key = key;
+    entry.vertex = vertex;
+    heap.push_back(entry);
+    siftUp(heap.size() - 1);
+}
+
+void IndexedPriorityQueue::decreaseKey(int vertex, float key) {
+    int i = position[vertex];
+    heap[i].key = key;
+    siftUp(i);
+}
+
+int IndexedPriorityQueue::pop() {
+    int vertex = heap[0].vertex;
+    position[vertex] = -1;
+    Entry last = heap.back();
+    heap.pop_back();
+    if (!heap.empty()) {
+        heap[0] = last;
+        siftDown(0);
+    }
+    return vertex;
+}
+
+void IndexedPriorityQueue::clear() {
+    for (const auto& entry : heap) { position[entry.vertex] = -1; }
+    heap.clear();
+}
@@ -0,0 +1,76 @@
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+#include <vector>
+
+using namespace std;
+
+/**
+ * Binary min-heap of graph vertices (dense indices) keyed by a float priority. Every vertex
+ * knows its position in the heap, so contains() is O(1) and decreaseKey() is O(log n).
+ */
+class IndexedPriorityQueue
+{
+    private:
+
+    /** A queued vertex and its priority. */
+    struct Entry
+    {
+        float key;
+        int vertex;
+    };
+
+    /** Entries in heap order. */
+    vector<Entry> heap;
+
+    /** Position of each vertex in the heap (-1 if not queued). */
+    vector<int> position;
+
+    /** Moves the entry at index i up until the heap property holds. */
+    void siftUp(int i);
+
+    /** Moves the entry at index i down until the heap property holds. */
+    void siftDown(int i);
+
+    public:
+
+    /** Constructs an empty queue for vertices in [0, capacity). */
+    IndexedPriorityQueue(int capacity);
+
+    /** Returns true if the vertex is queued. */
+    inline bool contains(int vertex) const { return position[vertex] != -1; }
+
+    /** Returns the priority of a queued vertex. */
+    inline float getKey(int vertex) const { return heap[position[vertex]].key; }
+
+    /** Returns the vertex with the smallest priority. */
+    inline int top() const { return heap[0].vertex; }
+
+    /** Returns the smallest priority. */
+    inline float topKey() const { return heap[0].key; }
+
+    /** Returns the vertex at position index in the heap, for visiting every queued vertex in [0, size()). */
+    inline int getVertex(int index) const { return heap[index].vertex; }
+
+    /** Getters. */
+    inline int size() const { return heap.size(); }
+    inline bool isEmpty() const { return heap.empty(); }
+    inline int getCapacity() const { return position.size(); }
+
+    /** Returns the bytes of heap the queue holds. */
+    inline size_t getHeapBytes() const { return heap.capacity() * sizeof(Entry) + position.capacity() * sizeof(int); }
+
+    /** Queues a vertex that is not queued yet. */
+    void push(int vertex, float key);
+
+    /** Lowers the priority of a queued vertex. */
+    void decreaseKey(int vertex, float key);
+
+    /** Removes and returns the vertex with the smallest priority. */
+    int pop();
+
+    /** Removes every queued vertex (O(size), not O(capacity)). */
+    void clear();
+};
+
+#endif
@@ -1,8 +1,11 @@
 #ifndef SEARCH_H
 #define SEARCH_H
 
+#include <cmath>
+#include <cstdlib>
 #include "../graph/graph.h"
-#include "../level/level.h"    
+#include "../level/level.h"
+#include "../level/transform.h"
 
 /** Any GraphNode in search is either open, closed, unvisited, or visited. */
 enum GraphNodeRecordState
@@ -14,57 +17,33 @@ enum GraphNodeRecordState
     failed
 };
 
-/** Used for path finding algorithms. Stores a GraphNode and its relative state for pathfinding purposes. */
-class GraphNodeRecord
+/**
+ * Represents the locations that complete a path (the result of a search), start to end. A table
+ * from location to index alongside makes finding where a position is on the path O(1).
+ */
+class Path
 {
-
     private:
-    /** GraphNode to record.*/
-    GraphNode node;
 
-    /** GraphNode state. */
-    GraphNodeRecordState state;
+    /** The locations in the path (order matters). */
+    vector<Location> path;
 
-    /** Accumulated cost of the node (CSF). */
-    float costSoFar;
+    /** Open addressing table of indices into path, keyed by location (-1 if empty slot). */
+    vector<int> table;
 
-    /** Accumulated cost of the node plus heuristic of node (ETC = CSF + H). */
-    float estimatedTotalCost;
+    /** Returns the slot in table holding location's index, or the empty slot it belongs in. */
+    int findSlot(const Location& location) const;
 
-    /** Connection between this record to another. */
-    Edge edge;
-
-    public:
-    /* Construct a GraphNodeRecord with all its fields. */
-    GraphNodeRecord(const GraphNode& n, const GraphNodeRecordState& s);
-
-    /** Setters. */
-    void setState(GraphNodeRecordState newState);
-    void setCostSoFar(float csf);
-    void setEstimatedTotalCost(float est);
-    void setEdge(Edge newEdge);
-
-    /** Getters. */
-    GraphNode getNode() const;
-    GraphNodeRecordState getState() const;
-    float getCostSoFar() const;
-    float getEstimatedTotalCost() const;
-    Location getLocation() const;
-    Edge getEdge() const;
-};
-
-/** Represents the list of GraphRecords that complete a path. */
-class Path
-{
-    private:
-
-    /** The list of GraphNodeRecords in the path (order matters). */
-    vector<GraphNodeRecord> path;
+    /** Rebuilds table for the locations in path, growing it to stay at most half full. */
+    void reindex();
 
     public:
 
     int exploredNodes = 0; // TODO: Make private
 
+    /** Proven bound on the path's cost over the optimal cost, set by bounded searches (0 if not reported). */
+    float bound = 0;
+
     /** Returns size of path. */
     int size() const;
 
@@ -72,34 +51,34 @@ class Path
     bool isEmpty() const;
 
     /** Returns the path list. */
-    vector<GraphNodeRecord> getPathList() const;
+    const vector<Location>& getPathList() const;
 
-    /** Returns GraphNodeRecord with smallest CSF.*/
-    GraphNodeRecord getSmallestCSF() const;
+    /** Returns the location at index on the path. */
+    inline const Location& getLocation(int index) const { return path[index]; }
 
-    /** Returns GraphNodeRecord with smallest EST.*/
-    GraphNodeRecord getSmallestEST() const;
+    /** Returns the (first) index of the location on the path, or -1 if it is not on it. O(1). */
+    int find(const Location& location) const;
 
-    /** Return true if node is in Path. */
-    bool contains(const GraphNode& node) const;
+    /** Returns the bytes of heap the path holds. */
+    inline size_t getHeapBytes() const { return path.capacity() * sizeof(Location) + table.capacity() * sizeof(int); }
 
-    /** Return GraphNodeRecord in Path of corresponding GraphNode. */
-    GraphNodeRecord find(const GraphNode& node) const;
+    /** Adds location to the end of the path. */
+    void add(const Location& location);
 
-    /** Return GraphNodeRecord in Path of corresponding Vertex. */
-    GraphNodeRecord find(const graph::Vertex& vertex) const;
+    /** Empties the path, keeping its storage for reuse. */
+    void clear();
 
-    /** Adds GraphNodeRecord to Path. */
-    void add(const GraphNodeRecord& record);
+    /** Reverses the order of the path in place. */
+    void reverse();
 
-    /** Removes GraphNodeRecord to Path. */
-    void remove(const GraphNodeRecord& record);
+    /** Reverses the order of the locations from index first to the end in place. */
+    void reverse(int first);
 
     /** Returns the index of the future position with respect to the current index on the path. */
-    int getIndex(const Vector2f& futurePosition, int currentIndexOnPath) const;
+    int getIndex(const GridTransform& transform, const Vector2f& futurePosition, int currentIndexOnPath) const;
 
     /** Returns the index of the future position with respect to the current index on the path. */
-    Vector2f getPosition(int index) const;
+    Vector2f getPosition(const GridTransform& transform, int index) const;
 
     Location getLast() const;
 
@@ -108,12 +87,12 @@ class Path
         if (path.size() == 0) { return sfml; }
         int end = path.size() - 1;
 
-        Location start(path[0].getLocation().y, path[0].getLocation().x);
+        Location start(path[0].y, path[0].x);
         sfml.push_back(LevelCell(start, 1));
         for (int i = 1; i < end; i++) {
-            sfml.push_back(LevelCell(Location(path[i].getLocation().y, path[i].getLocation().x), 2));
+            sfml.push_back(LevelCell(Location(path[i].y, path[i].x), 2));
         }
-        Location endd(path[end].getLocation().y, path[end].getLocation().x);
+        Location endd(path[end].y, path[end].x);
         sfml.push_back(LevelCell(endd, 3));
         return sfml;
     }
@@ -127,19 +106,19 @@ class Path
         if (path.size() == 0) { return; }
 
         // Draw start.
-        Location startLocation = Location(path[0].getLocation().y, path[0].getLocation().x);
+        Location startLocation = Location(path[0].y, path[0].x);
         LevelCell startCell(startLocation, 1);
         startCell.draw(window);
 
         // Draw inbetween.
-        for (int i = 1; i < path.size() - 1; i++) {
-            Location location(path[i].getLocation().y, path[i].getLocation().x);
+        for (int i = 1; i < int(path.size()) - 1; i++) {
+            Location location(path[i].y, path[i].x);
             LevelCell cell(location, 2);
             cell.draw(window);
         }
 
         // Draw end.
-        Location endLocation = Location(path[path.size() - 1].getLocation().y, path[path.size() - 1].getLocation().x);
+        Location endLocation = Location(path[path.size() - 1].y, path[path.size() - 1].x);
         LevelCell endCell(endLocation, 3);
         endCell.draw(window);
     }
@@ -151,8 +130,8 @@ class Search
 
     private:
 
-    /** The graph to search. */
-    const graph::Graph graph;
+    /** The graph to search (shared, never copied). */
+    const graph::GraphHandle graph;
 
     /** The start location in the graph. */
     const Location start;
@@ -163,7 +142,7 @@ class Search
     public:
 
     /** Default constructor for Search class. */
-    Search(const Graph& graph, const Location& start, const Location& end);
+    Search(const GraphHandle& graph, const Location& start, const Location& end);
 
     /**
      * @brief Returns a path from the start to end location
@@ -177,16 +156,17 @@ class Search
 
     /** Maps vertex in graph to location in level. */
     inline Location localize(const graph::Vertex& vertex) const {
-        return graph.localize(vertex);
+        return graph->localize(vertex);
     }
 
     /** Maps location in level to GraphNode in graph. */
     inline GraphNode quantize(const Location& location) const {
-        return graph.quantize(location);
+        return graph->quantize(location);
     }
 
     /** Getters. */
-    Graph getGraph() const;
+    const Graph& getGraph() const;
+    const GraphHandle& getGraphHandle() const;
     Location getStart() const;
     Location getEnd() const;
 };
@@ -194,6 +174,8 @@ class Search
 /**
  * Heuristic is function that returns a value representing a cost
  * from one location to a set goal location (all of which is in a graph).
+ * The distance heuristics below are final with inline compute(), so a search instantiated for
+ * one of them (AStar::search is, when given it as its own type) calls it without virtual dispatch.
 */
 class Heuristic
 {
@@ -210,11 +192,11 @@ class Heuristic
     virtual float compute(const Location& location) const = 0;
 
     /** Getters. */
-    Location getGoalLocation() const;
+    inline const Location& getGoalLocation() const { return goalLocation; }
 };
 
 /** Manhattan distance heuristic. */
-class ManhattanHeuristic : public Heuristic
+class ManhattanHeuristic final : public Heuristic
 {
 
     public:
@@ -222,12 +204,14 @@ class ManhattanHeuristic : public Heuristic
     /** Default constructor. */
     ManhattanHeuristic(const Location& goal);
 
-    /** Returns heuristic value of location to goal location. */
-    float compute(const Location& location) const;
+    /** Returns heuristic value of location to goal location (summed in integers, converted once). */
+    inline float compute(const Location& location) const {
+        return float(abs(getGoalLocation().x - location.x) + abs(getGoalLocation().y - location.y));
+    }
 };
 
 /** Euclidean distance heuristic. */
-class EuclideanHeuristic : public Heuristic
+class EuclideanHeuristic final : public Heuristic
 {
     public:
 
@@ -235,12 +219,16 @@ class EuclideanHeuristic : public Heuristic
     EuclideanHeuristic(const Location& goal);
 
     /** Returns heuristic value of location to goal location. */
-    float compute(const Location& location) const;
+    inline float compute(const Location& location) const {
+        int dx = getGoalLocation().x - location.x;
+        int dy = getGoalLocation().y - location.y;
+        return float(sqrt(double(dx * dx + dy * dy)));
+    }
 };
 
 
 /** Weighted distance heuristic. */
-class CustomHeuristic : public Heuristic
+class CustomHeuristic final : public Heuristic
 {
     public:
 
@@ -248,6 +236,10 @@ class CustomHeuristic : public Heuristic
     CustomHeuristic(const Location& goal);
 
     /** Returns heuristic value of location to goal location. */
-    float compute(const Location& location) const;
+    inline float compute(const Location& location) const {
+        int dx = getGoalLocation().x - location.x;
+        int dy = getGoalLocation().y - location.y;
+        return float(10.0 * sqrt(double(dx * dx + dy * dy)));
+    }
 };
 #endif
\ No newline at end of file
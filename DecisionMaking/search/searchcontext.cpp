@@ -0,0 +1,27 @@
+#include "priorityqueue.h"
+#include "bucketqueue.h"
+#include "searchstate.h"
+#include "searchcontext.h"
+
+using namespace std;
+
+SearchContext::SearchContext(int size) : state(size), openList(size), bucketQueue(0, 0), focalList(0) {}
+
+void SearchContext::reset() {
+    state.reset();
+    openList.clear();
+    bucketQueue.clear();
+    focalList.clear();
+}
+
+BucketQueue& SearchContext::getBucketQueue(int maxCost) {
+    if (bucketQueue.getCapacity() != size() || bucketQueue.getMaxCost() != maxCost) {
+        bucketQueue = BucketQueue(size(), maxCost);
+    }
+    return bucketQueue;
+}
+
+IndexedPriorityQueue& SearchContext::getFocalList() {
+    if (focalList.getCapacity() != size()) { focalList = IndexedPriorityQueue(size()); }
+    return focalList;
+}
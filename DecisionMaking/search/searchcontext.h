@@ -0,0 +1,56 @@
+#ifndef SEARCH_CONTEXT_H
+#define SEARCH_CONTEXT_H
+
+#include "priorityqueue.h"
+#include "bucketqueue.h"
+#include "searchstate.h"
+
+using namespace std;
+
+/**
+ * Everything a search allocates per graph vertex: the per-vertex state and the open lists.
+ * Allocate one per graph (e.g. per agent) and pass it to every query on that graph; after
+ * the first query, repeated searches allocate nothing and resetting is O(1) in graph size.
+ */
+class SearchContext
+{
+    private:
+
+    /** Per-vertex search state (generation stamped). */
+    SearchState state;
+
+    /** Open list, indexed by vertex. */
+    IndexedPriorityQueue openList;
+
+    /** Open list for small integer edge costs (allocated on first use). */
+    BucketQueue bucketQueue;
+
+    /** Second open list for searches that order their frontier two ways (allocated on first use). */
+    IndexedPriorityQueue focalList;
+
+    public:
+
+    /** Constructs a context for graphs with vertices in [0, size). */
+    SearchContext(int size);
+
+    /** Readies the context for a new search. */
+    void reset();
+
+    /** Getters. */
+    inline SearchState& getState() { return state; }
+    inline IndexedPriorityQueue& getOpenList() { return openList; }
+
+    /** Returns the bucket open list, (re)allocating it if it was made for other edge costs. */
+    BucketQueue& getBucketQueue(int maxCost);
+
+    /** Returns the second open list, allocating it on first use. */
+    IndexedPriorityQueue& getFocalList();
+    inline int size() const { return state.size(); }
+
+    /** Returns the bytes of heap the context holds (which repeated searches reuse rather than allocate). */
+    inline size_t getHeapBytes() const {
+        return state.getHeapBytes() + openList.getHeapBytes() + bucketQueue.getHeapBytes() + focalList.getHeapBytes();
+    }
+};
+
+#endif
@@ -0,0 +1,75 @@
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include "../graph/graph.h"
+#include "searchcontext.h"
+#include "search.h"
+#include "a*.h"
+#include "dijsktra.h"
+#include "searchpool.h"
+
+using namespace std;
+using namespace std::chrono;
+
+SearchPool::SearchPool(const GraphHandle& graph, int threads) :
+    graph(graph), queries(nullptr), results(nullptr), batch(0), busy(0), stopping(false), next(0) {
+    if (threads <= 0) { threads = max(1u, thread::hardware_concurrency()); }
+    for (int i = 0; i < threads; i++) { workers.push_back(thread(&SearchPool::work, this, i)); }
+}
+
+SearchPool::~SearchPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    started.notify_all();
+    for (auto& worker : workers) { worker.join(); }
+}
+
+void SearchPool::run(const vector<PathQuery>& queries, vector<PathResult>& results) {
+    results.resize(queries.size());
+    unique_lock<mutex> guard(lock);
+    this->queries = &queries;
+    this->results = &results;
+    next = 0;
+    busy = workers.size();
+    batch++;
+    started.notify_all();
+    finished.wait(guard, [this]() { return busy == 0; });
+}
+
+void SearchPool::work(int worker) {
+    const Graph& graph = *this->graph;
+    SearchContext context(graph.size());
+    unsigned int seen = 0;
+    while (true) {
+        const vector<PathQuery>* queries;
+        vector<PathResult>* results;
+        {
+            unique_lock<mutex> guard(lock);
+            started.wait(guard, [this, seen]() { return stopping || batch != seen; });
+            if (stopping) { return; }
+            seen = batch;
+            queries = this->queries;
+            results = this->results;
+        }
+
+        // Take queries until the batch runs out (each result is written by one worker only).
+        int count = queries->size();
+        for (int i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            const PathQuery& query = (*queries)[i];
+            PathResult& result = (*results)[i];
+            auto startTime = steady_clock::now();
+            if (query.heuristic != nullptr) { AStar::search(graph, query.start, query.end, *query.heuristic, context, result.path); }
+            else { Dijkstra::search(graph, query.start, query.end, context, result.path); }
+            result.microseconds = duration_cast<microseconds>(steady_clock::now() - startTime).count();
+            result.worker = worker;
+        }
+
+        lock_guard<mutex> guard(lock);
+        if (--busy == 0) { finished.notify_all(); }
+    }
+}
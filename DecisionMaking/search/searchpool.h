@@ -0,0 +1,90 @@
+#ifndef SEARCH_POOL_H
+#define SEARCH_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include "../graph/graph.h"
+#include "search.h"
+
+using namespace std;
+
+/** One query of a batch: A* from start to end guided by heuristic, or Dijkstra if it is null. */
+struct PathQuery
+{
+    Location start;
+    Location end;
+
+    /** Heuristic of the query (computed from worker threads, so it must not change state). */
+    const Heuristic* heuristic;
+
+    inline PathQuery(const Location& start, const Location& end, const Heuristic* heuristic = nullptr) :
+        start(start), end(end), heuristic(heuristic) {}
+};
+
+/** Answer to one query of a batch, with its stats. */
+struct PathResult
+{
+    /** Path found (empty if there is none), and the nodes explored finding it. */
+    Path path;
+
+    /** Time spent searching. */
+    long long microseconds = 0;
+
+    /** Worker that ran the query. */
+    int worker = -1;
+};
+
+/**
+ * Fixed pool of worker threads answering batches of path queries on one shared graph. The
+ * graph is immutable behind its handle, and each worker owns its search context, so workers
+ * share nothing but the index of the next query. Queries are handed out one at a time, which
+ * balances long and short queries across workers.
+ */
+class SearchPool
+{
+    private:
+
+    /** The graph every query runs on. */
+    GraphHandle graph;
+
+    /** Worker threads. */
+    vector<thread> workers;
+
+    /** Guards the batch fields below. */
+    mutex lock;
+    condition_variable started;
+    condition_variable finished;
+
+    /** Current batch: its queries and results, a counter bumped per batch, and workers not yet done with it. */
+    const vector<PathQuery>* queries;
+    vector<PathResult>* results;
+    unsigned int batch;
+    int busy;
+    bool stopping;
+
+    /** Index of the next query to hand out. */
+    atomic<int> next;
+
+    /** Runs queries of each batch until the pool is destroyed. */
+    void work(int worker);
+
+    public:
+
+    /** Starts the given number of workers on graph (0 for one per hardware thread). */
+    SearchPool(const GraphHandle& graph, int threads = 0);
+
+    /** Stops and joins the workers. */
+    ~SearchPool();
+
+    /** Answers every query into the result of the same index, blocking until all are done. */
+    void run(const vector<PathQuery>& queries, vector<PathResult>& results);
+
+    /** Getters. */
+    inline int getThreadCount() const { return workers.size(); }
+    inline const Graph& getGraph() const { return *graph; }
+};
+
+#endif
@@ -0,0 +1,21 @@
+#include <vector>
+#include <algorithm>
+#include "../graph/graph.h"
+#include "search.h"
+#include "searchstate.h"
+
+using namespace std;
+
+SearchState::SearchState(int size) :
+    costSoFar(size, 0), estimatedTotalCost(size, 0), parent(size, -1), state(size, GraphNodeRecordState::unvisited),
+    stamp(size, 0), generation(1) {}
+
+void SearchState::reset() {
+    generation++;
+
+    // Stamps only repeat after 2^32 searches, when they are cleared for real.
+    if (generation == 0) {
+        fill(stamp.begin(), stamp.end(), 0);
+        generation = 1;
+    }
+}
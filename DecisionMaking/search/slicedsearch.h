@@ -0,0 +1,108 @@
+#ifndef SLICED_SEARCH_H
+#define SLICED_SEARCH_H
+
+#include <vector>
+#include <memory>
+#include "../graph/graph.h"
+#include "search.h"
+#include "searchcontext.h"
+
+using namespace std;
+
+/** Progress of a resumable search. */
+enum SearchStatus
+{
+    SEARCH_IDLE,
+    SEARCH_IN_PROGRESS,
+    SEARCH_COMPLETE
+};
+
+/**
+ * A* that runs in slices: each step expands at most a given number of vertices (or runs for at
+ * most a given time) and returns, keeping its open list and per-vertex state in its own context
+ * until the next step, so a long search spreads over frames instead of blocking one.
+ */
+class SlicedAStar
+{
+    private:
+
+    /** Graph searched, and the context holding the search between steps. */
+    GraphHandle graph;
+    SearchContext context;
+
+    /** Heuristic of the current search (shared, as it must live until the search completes). */
+    shared_ptr<const Heuristic> heuristic;
+
+    /** Locations and vertices of the current search. */
+    Location start;
+    Location end;
+    int startVertex;
+    int endVertex;
+
+    /** Vertices closed so far (the path's explored nodes) and expanded over all steps. */
+    int closedCount;
+    int expanded;
+
+    /** Progress, and the path found once complete (empty if there is none). */
+    SearchStatus status;
+    Path path;
+
+    public:
+
+    /** Constructs an idle search on graph. */
+    SlicedAStar(const GraphHandle& graph);
+
+    /** Starts searching from start to end guided by heuristic, dropping any search in progress. */
+    void begin(const Location& start, const Location& end, const shared_ptr<const Heuristic>& heuristic);
+
+    /**
+     * Expands at most maxExpansions vertices, stopping early past maxMicroseconds (if positive)
+     * or once the search completes. Returns the search's progress.
+     */
+    SearchStatus step(int maxExpansions, long long maxMicroseconds = 0);
+
+    /** Drops the search in progress. */
+    void cancel();
+
+    /** Getters. */
+    inline SearchStatus getStatus() const { return status; }
+    inline bool isSearching() const { return status == SEARCH_IN_PROGRESS; }
+    inline const Path& getPath() const { return path; }
+    inline const Heuristic& getHeuristic() const { return *heuristic; }
+    inline const Location& getStart() const { return start; }
+    inline const Location& getEnd() const { return end; }
+    inline int getExpanded() const { return expanded; }
+};
+
+/**
+ * Divides a per-frame search budget among sliced searches with pending requests. Each frame
+ * every pending search gets an even share of what is left of the budget, repeatedly until the
+ * budget is spent or none is pending, so searches finishing early leave their share to others.
+ */
+class SearchScheduler
+{
+    private:
+
+    /** Searches in progress, in the order they are served. */
+    vector<SlicedAStar*> pending;
+
+    /** Expansions and time (0 for unlimited) spent per frame. */
+    int expansions;
+    long long microseconds;
+
+    public:
+
+    /** Constructs a scheduler spending at most the given expansions and time per frame. */
+    SearchScheduler(int expansions, long long microseconds = 0);
+
+    /** Queues a search that was begun, until it completes (no-op if queued). */
+    void submit(SlicedAStar& search);
+
+    /** Steps pending searches with one frame's budget. Returns the vertices expanded. */
+    int run();
+
+    /** Returns the number of pending searches. */
+    inline int size() const { return pending.size(); }
+};
+
+#endif
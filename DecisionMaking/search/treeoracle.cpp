@@ -0,0 +1,147 @@
+#include <vector>
+#include <queue>
+#include "../graph/graph.h"
+#include "../graph/gridgraph.h"
+#include "search.h"
+#include "treeoracle.h"
+
+using namespace std;
+
+template <class G>
+bool TreeOracle::isForest(const G& graph) {
+
+    // Every edge needs its reverse, and each undirected edge (counted from its smaller end) may not close a cycle.
+    vector<int> component(graph.size());
+    for (int vertex = 0; vertex < graph.size(); vertex++) { component[vertex] = vertex; }
+    for (int vertex = 0; vertex < graph.size(); vertex++) {
+        auto edges = graph.getOutgoingEdges(vertex);
+        for (int i = 0; i < edges.size(); i++) {
+            int target = edges.target(i);
+            auto reverseEdges = graph.getOutgoingEdges(target);
+            bool reversed = false;
+            for (int j = 0; j < reverseEdges.size() && !reversed; j++) { reversed = reverseEdges.target(j) == vertex; }
+            if (!reversed) { return false; }
+            if (target < vertex) { continue; }
+
+            // Union find with path halving.
+            int a = vertex;
+            int b = target;
+            while (component[a] != a) { a = component[a] = component[component[a]]; }
+            while (component[b] != b) { b = component[b] = component[component[b]]; }
+            if (a == b) { return false; }
+            component[a] = b;
+        }
+    }
+    return true;
+}
+
+template <class G>
+TreeOracle::TreeOracle(const G& graph) :
+    parent(graph.size(), -1), jump(graph.size()), depth(graph.size(), 0), root(graph.size(), -1),
+    upCost(graph.size(), 0), downCost(graph.size(), 0), rows(graph.getRows()), cols(graph.getCols()) {
+
+    // Root each tree at its first vertex and visit it breadth first, so parents come before children.
+    queue<int> open;
+    for (int first = 0; first < graph.size(); first++) {
+        if (root[first] != -1) { continue; }
+        root[first] = first;
+        jump[first] = first;
+        open.push(first);
+        while (!open.empty()) {
+            int vertex = open.front();
+            open.pop();
+            auto edges = graph.getOutgoingEdges(vertex);
+            for (int i = 0; i < edges.size(); i++) {
+                int child = edges.target(i);
+                if (child == parent[vertex]) { continue; }
+                parent[child] = vertex;
+                depth[child] = depth[vertex] + 1;
+                root[child] = first;
+                downCost[child] = downCost[vertex] + edges.cost(i);
+
+                // The reverse edge's cost.
+                auto childEdges = graph.getOutgoingEdges(child);
+                for (int j = 0; j < childEdges.size(); j++) {
+                    if (childEdges.target(j) == vertex) { upCost[child] = upCost[vertex] + childEdges.cost(j); }
+                }
+
+                // Jump twice as far as the parent if its jump and its jump's jump are equally long.
+                int up = jump[vertex];
+                bool doubles = depth[vertex] - depth[up] == depth[up] - depth[jump[up]];
+                jump[child] = doubles ? jump[up] : vertex;
+                open.push(child);
+            }
+        }
+    }
+}
+
+int TreeOracle::ancestor(int vertex, int atDepth) const {
+    while (depth[vertex] > atDepth) { vertex = depth[jump[vertex]] >= atDepth ? jump[vertex] : parent[vertex]; }
+    return vertex;
+}
+
+int TreeOracle::lowestCommonAncestor(int a, int b) const {
+    if (root[a] != root[b]) { return -1; }
+
+    // Climb to the same depth, then climb together (jumps only depend on depth, so they stay in step).
+    if (depth[a] > depth[b]) { a = ancestor(a, depth[b]); }
+    else { b = ancestor(b, depth[a]); }
+    while (a != b) {
+        if (jump[a] != jump[b]) {
+            a = jump[a];
+            b = jump[b];
+        }
+        else {
+            a = parent[a];
+            b = parent[b];
+        }
+    }
+    return a;
+}
+
+bool TreeOracle::isConnected(const Location& start, const Location& end) const {
+    if (!contains(start) || !contains(end)) { return false; }
+    return root[start.x * cols + start.y] == root[end.x * cols + end.y];
+}
+
+int TreeOracle::getLength(const Location& start, const Location& end) const {
+    if (!isConnected(start, end)) { return -1; }
+    int a = start.x * cols + start.y;
+    int b = end.x * cols + end.y;
+    return depth[a] + depth[b] - 2 * depth[lowestCommonAncestor(a, b)];
+}
+
+float TreeOracle::getCost(const Location& start, const Location& end) const {
+    if (!isConnected(start, end)) { return -1; }
+    int a = start.x * cols + start.y;
+    int b = end.x * cols + end.y;
+    int ancestor = lowestCommonAncestor(a, b);
+    return (upCost[a] - upCost[ancestor]) + (downCost[b] - downCost[ancestor]);
+}
+
+void TreeOracle::getPath(const Location& start, const Location& end, Path& path) const {
+    path.clear();
+    if (!isConnected(start, end)) { return; }
+
+    // A path to itself is start and end.
+    int a = start.x * cols + start.y;
+    int b = end.x * cols + end.y;
+    if (a == b) {
+        path.add(start);
+        path.add(end);
+        return;
+    }
+
+    // Climb from start to the common ancestor, then from end, and turn the second climb around.
+    int ancestor = lowestCommonAncestor(a, b);
+    for (int vertex = a; vertex != ancestor; vertex = parent[vertex]) { path.add(Location(vertex / cols, vertex % cols)); }
+    path.add(Location(ancestor / cols, ancestor % cols));
+    int descent = path.size();
+    for (int vertex = b; vertex != ancestor; vertex = parent[vertex]) { path.add(Location(vertex / cols, vertex % cols)); }
+    path.reverse(descent);
+}
+
+template bool TreeOracle::isForest<Graph>(const Graph&);
+template bool TreeOracle::isForest<GridGraph>(const GridGraph&);
+template TreeOracle::TreeOracle<Graph>(const Graph&);
+template TreeOracle::TreeOracle<GridGraph>(const GridGraph&);
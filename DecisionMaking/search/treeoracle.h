@@ -0,0 +1,92 @@
+#ifndef TREE_ORACLE_H
+#define TREE_ORACLE_H
+
+#include <vector>
+#include "../graph/graph.h"
+#include "search.h"
+
+using namespace std;
+
+/**
+ * Path oracle for graphs whose edges form a forest, like the perfect mazes of generateMaze()
+ * (a randomized DFS carves a spanning tree, so every two cells have exactly one path). Each tree
+ * is rooted once. Every vertex stores its parent, its depth, the costs of the paths to and
+ * from the root, and one jump pointer to an ancestor. Jumps have skew-binary lengths, so
+ * ancestors and lowest common ancestors are found in O(log n) with O(n) memory (unlike
+ * binary lifting tables, which need O(n log n)).
+ *
+ * The path between two vertices climbs from one to their lowest common ancestor and
+ * descends to the other. Its length and cost are O(log n), and the path itself is
+ * O(path length). Nothing is searched.
+ */
+class TreeOracle
+{
+    private:
+
+    /** Parent of each vertex (-1 for roots). */
+    vector<int> parent;
+
+    /** Ancestor each vertex jumps to (itself for roots). */
+    vector<int> jump;
+
+    /** Number of edges from each vertex to its root. */
+    vector<int> depth;
+
+    /** Root of each vertex's tree. */
+    vector<int> root;
+
+    /** Cost of the path from each vertex up to its root, and from its root down to it. */
+    vector<float> upCost;
+    vector<float> downCost;
+
+    /** Number of rows and columns of the graph (locations map to vertices as in Graph). */
+    int rows;
+    int cols;
+
+    /** Returns the ancestor of vertex at the given depth (at most vertex's depth). */
+    int ancestor(int vertex, int atDepth) const;
+
+    public:
+
+    /**
+     * Returns true if graph's edges form a forest: every edge has a reverse edge and the
+     * undirected edges have no cycle. Defined for Graph and GridGraph.
+     */
+    template <class G>
+    static bool isForest(const G& graph);
+
+    /** Roots every tree of graph, which must be a forest. Defined for Graph and GridGraph. */
+    template <class G>
+    TreeOracle(const G& graph);
+
+    /** Returns the lowest common ancestor of two vertices (-1 if they are in different trees). */
+    int lowestCommonAncestor(int a, int b) const;
+
+    /** Returns true if there is a path from start to end. */
+    bool isConnected(const Location& start, const Location& end) const;
+
+    /** Returns the number of edges on the path from start to end (-1 if there is none). O(log n). */
+    int getLength(const Location& start, const Location& end) const;
+
+    /** Returns the cost of the path from start to end (-1 if there is none). O(log n). */
+    float getCost(const Location& start, const Location& end) const;
+
+    /** Fills path with the path from start to end (empty if there is none). O(path length). */
+    void getPath(const Location& start, const Location& end, Path& path) const;
+
+    /** Returns true if the location is a tile of the graph. */
+    inline bool contains(const Location& location) const {
+        return location.x >= 0 && location.x < rows && location.y >= 0 && location.y < cols;
+    }
+
+    /** Returns the number of vertices. */
+    inline int size() const { return parent.size(); }
+
+    /** Returns the bytes of heap the oracle holds. */
+    inline size_t getHeapBytes() const {
+        return (parent.capacity() + jump.capacity() + depth.capacity() + root.capacity()) * sizeof(int) +
+            (upCost.capacity() + downCost.capacity()) * sizeof(float);
+    }
+};
+
+#endif
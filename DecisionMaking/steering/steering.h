@@ -15,7 +15,9 @@
 #include "../hparams/hyperparameters.h"
 #include "../math/vmath.h"
 #include "../search/search.h"
+#include "../search/flowfield.h"
 #include "../level/location.h"
+#include "../level/transform.h"
 #include "steeringoutput.h"
 
 using namespace sf;
@@ -261,13 +263,25 @@ class FollowPath : Arrive
 {
     private:
     Path path;
+    GridTransform transform;
     float pathOffset;
     int currentPathIndex;
     float predictionTime;
 
     public:
 
-    FollowPath(const Path& p, float o, float idx, float pt, float t, float r1, float r2, float s);
+    FollowPath(const Path& p, const GridTransform& g, float o, float idx, float pt, float t, float r1, float r2, float s);
+
+    /** Follows a new path from its start, reusing the storage of the current one. */
+    inline void setPath(const Path& p) {
+        path = p;
+        currentPathIndex = 0;
+    }
+
+    /** Follows a longer version of the current path (p starts with it), keeping the current index. */
+    inline void extendPath(const Path& p) {
+        path = p;
+    }
 
     inline SteeringOutput calculateAcceleration(const Kinematic& character, const Kinematic& notUsed) {
         if (path.size() == 0) {
@@ -280,29 +294,29 @@ class FollowPath : Arrive
             Kinematic newTarget;
 
             // If moving right or down, need to move more (sprite issues).
-            auto a = path.getPathList()[path.size() - 1].getLocation();
-            auto b = path.getPathList()[path.size() - 2].getLocation();
+            auto a = path.getLocation(path.size() - 1);
+            auto b = path.getLocation(path.size() - 2);
             auto d = getDirection(a, b);
             cout << "d: " << d << endl;
             if (d == 3) { // Moving right.
-                newTarget.position = flip(mapToWindow(SIZE, path.getLast()));
+                newTarget.position = transform.toWindow(path.getLast());
                 newTarget.position.x += 6;
 
             }
             else if (d == 2) { // Moving down.
-                newTarget.position = flip(mapToWindow(SIZE, path.getLast()));
+                newTarget.position = transform.toWindow(path.getLast());
                 newTarget.position.y += 6;
             }
             else { // Moving left or up.
-                newTarget.position = flip(mapToWindow(SIZE, path.getLast()));
+                newTarget.position = transform.toWindow(path.getLast());
             }
             return Arrive::calculateAcceleration(character, newTarget);
         }
         Vector2f futurePosition = character.position + (character.linearVelocity * predictionTime);
-        currentPathIndex = path.getIndex(futurePosition, currentPathIndex);
+        currentPathIndex = path.getIndex(transform, futurePosition, currentPathIndex);
         int newTargetPathIndex = currentPathIndex == path.size() - 1 ? currentPathIndex : currentPathIndex + pathOffset;
         Kinematic newTarget;
-        newTarget.position = path.getPosition(newTargetPathIndex);
+        newTarget.position = path.getPosition(transform, newTargetPathIndex);
 
         if (newTargetPathIndex >= path.size()) {
             currentPathIndex = path.size() - 1;
@@ -314,6 +328,33 @@ class FollowPath : Arrive
     }
 };
 
+/** Steers to the next cell of a flow field, so any number of characters share one search to its goal. */
+class FollowField : Arrive
+{
+    private:
+    const FlowField* field;
+    GridTransform transform;
+    float predictionTime;
+
+    public:
+
+    /** Constructs a behavior following field (which must outlive it). */
+    FollowField(const FlowField& f, const GridTransform& g, float pt, float t, float r1, float r2, float s);
+
+    inline SteeringOutput calculateAcceleration(const Kinematic& character, const Kinematic& notUsed) {
+
+        // Head on from where the character will be, or from where it is if that is off the field.
+        Vector2f futurePosition = character.position + (character.linearVelocity * predictionTime);
+        Location next = field->getNext(transform.toLevel(futurePosition));
+        if (next == Location(-1, -1)) { next = field->getNext(transform.toLevel(character.position)); }
+        if (next == Location(-1, -1)) { return SteeringOutput(); }
+
+        Kinematic newTarget;
+        newTarget.position = transform.toWindow(next);
+        return Arrive::calculateAcceleration(character, newTarget);
+    }
+};
+
 class Wander : Arrive
 {
 
@@ -383,7 +424,7 @@ class Wander : Arrive
 
         // Check if wander goes onto an invalid tile.
         cout << "target: " << target.position.x << " " << target.position.y << endl;
-        auto temp = mapToLevel(22, 29.0909, target.position);
+        auto temp = GRID_TRANSFORM.toLevel(target.position);
         if (temp == Location(-1, -1)) {
             cout << "OH NO!" << endl;
             return SteeringOutput();
@@ -4,6 +4,9 @@
 #include "../steering/steering.h"
 #include "../search/a*.h"
 #include "../search/search.h"
+#include "../search/flowfield.h"
+#include "../search/slicedsearch.h"
+#include "../search/pathservice.h"
 #include "../scene/scene.h"
 #include "../decision/decisiontree.h"
 #include "../decision/behaviortree.h"
@@ -28,6 +31,17 @@ void Visualizer() {
     auto monsterTexture = initializeMonsterTexture();
     auto monster = initializeMonster(monsterCrumbs, monsterTexture);
 
+    // Swarm assets, steering by one flow field to the character.
+    FlowField field(environment.getGraph());
+    FollowField followField(field, GRID_TRANSFORM, PREDICTION_TIME, TIME_TO_REACH_TARGET_SPEED, RADIUS_OF_ARRIVAL, RADIUS_OF_DECELERATION, MAX_SPEED);
+    vector<int> cells = openCells(*environment.getGraph());
+    vector<vector<Crumb>*> swarmCrumbs;
+    vector<Character*> swarm;
+    for (int i = 0; i < SWARM_MONSTERS; i++) {
+        swarmCrumbs.push_back(initializeCrumbs());
+        swarm.push_back(initializeMonster(swarmCrumbs.back(), monsterTexture, environment.getGraph()->localize(cells[rand() % cells.size()])));
+    }
+
     // Level assests.
     auto levelTexture = generateLevelTexture(environment.getLevel());
     Sprite levelSprite(levelTexture->getTexture());
@@ -45,7 +59,7 @@ void Visualizer() {
     Sprite mpathSprite;
 
     // Path following.
-    FollowPath pathFollowing(Path(), PATH_OFFSET, 0, PREDICTION_TIME, TIME_TO_REACH_TARGET_SPEED, RADIUS_OF_ARRIVAL, RADIUS_OF_DECELERATION, MAX_SPEED);
+    FollowPath pathFollowing(Path(), GRID_TRANSFORM, PATH_OFFSET, 0, PREDICTION_TIME, TIME_TO_REACH_TARGET_SPEED, RADIUS_OF_ARRIVAL, RADIUS_OF_DECELERATION, MAX_SPEED);
     bool* followingPath = new bool(false);
     bool* newPathExists = new bool(false);
     bool* monsterClose = new bool(false);
@@ -56,14 +70,21 @@ void Visualizer() {
     Mouse mouse;
 
     // Additional state for DecisionTree.
-    Location* mouseLocation = new Location(mapToLevel(MAZE_X, SIZE, Vector2f(mouse.getPosition())));
+    Location* mouseLocation = new Location(GRID_TRANSFORM.toLevel(Vector2f(mouse.getPosition())));
     float* dt = new float(0.f);
 
+    // Searches the trees begin are spread over frames within a budget.
+    SearchScheduler scheduler(SEARCH_EXPANSIONS_PER_FRAME, SEARCH_MICROSECONDS_PER_FRAME);
+
+    // Paths the monster requests are searched on background threads (none without threads).
+    unique_ptr<PathService> service;
+    if (PATH_SERVICE_THREADS > 0) { service.reset(new PathService(environment.getGraph(), PATH_SERVICE_THREADS)); }
+
     // DecisionTree.
-    CharacterDecisionTree characterTree(environment.getGraph(), character, mouseLocation, dt, monsterClose, followingPath);
+    CharacterDecisionTree characterTree(environment.getGraph(), character, mouseLocation, dt, monsterClose, followingPath, environment.getPathTable(), environment.getPathCache(), &scheduler);
 
     // BehaviorTree.
-    MonsterBehaviorTree monsterTree(environment.getGraph(), character, monster, dt);
+    MonsterBehaviorTree monsterTree(environment.getGraph(), character, monster, dt, environment.getPathTable(), environment.getPathCache(), service.get());
 
     // Animate.
     cout << "Rendering level..." << endl;
@@ -80,7 +101,7 @@ void Visualizer() {
                 case Event::MouseButtonPressed:
                     if (*followingPath == false) {
                         // TODO: Inverse the mouse location or the visualizer?
-                        *mouseLocation = mapToLevel(MAZE_X, SIZE, Vector2f(mouse.getPosition(sceneView.scene)));
+                        *mouseLocation = GRID_TRANSFORM.toLevel(Vector2f(mouse.getPosition(sceneView.scene)));
                         *newPathExists = true;
                         *followingPath = true;
                     }
@@ -99,11 +120,11 @@ void Visualizer() {
         // Mark followingPath (decision tree).
         if (*followingPath) {
             if (!characterTree.getPath().isEmpty()) {
-                auto path = characterTree.getPath();
-                auto a = path.getPathList()[path.size() - 1].getLocation();
-                auto b = path.getPathList()[path.size() - 2].getLocation();
+                const Path& path = characterTree.getPath();
+                auto a = path.getLocation(path.size() - 1);
+                auto b = path.getLocation(path.size() - 2);
                 auto d = getDirection(a, b);
-                auto t = flip(mapToWindow(SIZE, path.getLast()));
+                auto t = GRID_TRANSFORM.toWindow(path.getLast());
                 if (d == 3) { t.x += 6; }
                 if (d == 2) { t.y += 6; }
                 if (closeEnough(character->getPosition(), t)) {
@@ -114,7 +135,7 @@ void Visualizer() {
 
         // Update path first iteration of tree path finding (decision tree).
         if (*followingPath) {
-            if (!characterTree.getPath().isEmpty() && characterTree.getFollowingIteration() == 1) {
+            if (characterTree.takeNewPath() && !characterTree.getPath().isEmpty()) {
                 pathSFML = characterTree.getPath().toSFML();
                 pathTexture.clear(sf::Color{ 255,255,255,0 });
                 for (const auto& element : pathSFML) { pathTexture.draw(element); }
@@ -126,13 +147,16 @@ void Visualizer() {
         // Behavior tree makes decision.
         monsterTree.run();
 
+        // Spend this frame's search budget on pending searches.
+        scheduler.run();
+
         if (monsterTree.isChasing) {
             if (!monsterTree.getPath().isEmpty()) {
-                auto path = monsterTree.getPath();
-                auto a = path.getPathList()[path.size() - 1].getLocation();
-                auto b = path.getPathList()[path.size() - 2].getLocation();
+                const Path& path = monsterTree.getPath();
+                auto a = path.getLocation(path.size() - 1);
+                auto b = path.getLocation(path.size() - 2);
                 auto d = getDirection(a, b);
-                auto t = flip(mapToWindow(SIZE, path.getLast()));
+                auto t = GRID_TRANSFORM.toWindow(path.getLast());
                 if (d == 3) { t.x += 6; }
                 if (d == 2) { t.y += 6; }
                 if (closeEnough(monster->getPosition(), t)) {
@@ -150,6 +174,12 @@ void Visualizer() {
             }
         }
 
+        // Swarm follows the field, repaired as the character steps between cells.
+        if (!swarm.empty()) { field.setGoal(character->getLocation()); }
+        for (auto swarmMonster : swarm) {
+            swarmMonster->update(followField.calculateAcceleration(swarmMonster->getKinematic(), Kinematic()), *dt, true);
+        }
+
         cout << "\n\n";
 
         if (snatched(monster, character)) {
@@ -162,20 +192,21 @@ void Visualizer() {
             monster = initializeMonster(monsterCrumbs, monsterTexture);
 
             // Path following.
-            FollowPath pathFollowing(Path(), PATH_OFFSET, 0, PREDICTION_TIME, TIME_TO_REACH_TARGET_SPEED, RADIUS_OF_ARRIVAL, RADIUS_OF_DECELERATION, MAX_SPEED);
+            FollowPath pathFollowing(Path(), GRID_TRANSFORM, PATH_OFFSET, 0, PREDICTION_TIME, TIME_TO_REACH_TARGET_SPEED, RADIUS_OF_ARRIVAL, RADIUS_OF_DECELERATION, MAX_SPEED);
             *followingPath = false;
             *newPathExists = false;
             *monsterClose = false;
 
             // Additional state for DecisionTree.
-            *mouseLocation = Location(mapToLevel(MAZE_X, SIZE, Vector2f(mouse.getPosition())));
+            *mouseLocation = Location(GRID_TRANSFORM.toLevel(Vector2f(mouse.getPosition())));
             *dt = 0.f;
 
             // DecisionTree.
-            characterTree = CharacterDecisionTree(environment.getGraph(), character, mouseLocation, dt, monsterClose, followingPath);
+            characterTree = CharacterDecisionTree(environment.getGraph(), character, mouseLocation, dt, monsterClose, followingPath, environment.getPathTable(), environment.getPathCache(), &scheduler);
 
-            // BehaviorTree.
-            monsterTree = MonsterBehaviorTree(environment.getGraph(), character, monster, dt);
+            // BehaviorTree (its request in flight would otherwise keep the path service busy).
+            monsterTree.cancelChase();
+            monsterTree = MonsterBehaviorTree(environment.getGraph(), character, monster, dt, environment.getPathTable(), environment.getPathCache(), service.get());
         }
 
         // Re-draw scene.
@@ -185,9 +216,17 @@ void Visualizer() {
         // if (monsterTree.isChasing) { sceneView.scene.draw(mpathSprite); }
         sceneView.scene.draw(character->sprite);
         sceneView.scene.draw(monster->sprite);
+        for (auto swarmMonster : swarm) { sceneView.scene.draw(swarmMonster->sprite); }
         sceneView.scene.display();
     }
 
+    // Path cache statistics.
+    if (environment.getPathCache() != nullptr) {
+        const PathCacheStats& stats = environment.getPathCache()->getStats();
+        cout << "Path cache: " << stats.hits << " hits, " << stats.suffixHits << " suffix hits, " << stats.misses << " misses, "
+            << stats.evictions << " evictions, " << stats.invalidations << " invalidations (hit rate " << stats.getHitRate() << ")" << endl;
+    }
+
     // Free any allocated memory.
     delete levelTexture;
     delete characterCrumbs;
@@ -196,6 +235,8 @@ void Visualizer() {
     delete monsterCrumbs;
     delete monsterTexture;
     delete monster;
+    for (auto swarmMonster : swarm) { delete swarmMonster; }
+    for (auto crumbs : swarmCrumbs) { delete crumbs; }
     delete followingPath;
     delete newPathExists;
     delete monsterClose;
@@ -39,7 +39,7 @@ Character* initializeCharacter(vector<Crumb>* crumbs, Texture* texture) {
     character->texture = *texture;
     character->sprite = *(new Sprite(*texture));
     character->sprite.setScale(scale, scale);
-    Vector2f start = mapToWindow(SIZE, Location(1, 1));
+    Vector2f start = GRID_TRANSFORM.toWindow(Location(1, 1));
     Kinematic initialState;
     initialState.position = start;
     character->setKinematic(initialState);
@@ -53,7 +53,7 @@ Texture* initializeMonsterTexture() {
     return texture;
 }
 
-Character* initializeMonster(vector<Crumb>* crumbs, Texture* texture) {
+Character* initializeMonster(vector<Crumb>* crumbs, Texture* texture, const Location& location) {
     // float scale = 1.5 / SIZE;
     float scale = 3 / SIZE;
     Character* character = new Character(crumbs);
@@ -61,8 +61,8 @@ Character* initializeMonster(vector<Crumb>* crumbs, Texture* texture) {
     character->texture = *texture;
     character->sprite = *(new Sprite(*texture));
     character->sprite.setScale(scale, scale);
-    // Vector2f start = mapToWindow(SIZE, Location(18, 18));
-    Vector2f start = mapToWindow(SIZE, Location(14, 14));
+    // Vector2f start = GRID_TRANSFORM.toWindow(Location(18, 18));
+    Vector2f start = GRID_TRANSFORM.toWindow(location);
     Kinematic initialState;
     initialState.position = start;
     character->setKinematic(initialState);
@@ -85,8 +85,9 @@ RenderTexture* generateLevelTexture(const Level& level) {
 }
 
 Path getPath(const Environment& environment, const Vector2f& start_, const Vector2f& end_) {
-    Location start = mapToLevel(environment.rows, SIZE, start_);
-    Location end = mapToLevel(environment.rows, SIZE, end_);
-    AStar search(environment.getGraph(), start, end, ManhattanHeuristic(end));
+    Location start = GRID_TRANSFORM.toLevel(start_);
+    Location end = GRID_TRANSFORM.toLevel(end_);
+    ManhattanHeuristic heuristic(end);
+    AStar search(environment.getGraph(), start, end, heuristic);
     return search.search();
 }
\ No newline at end of file
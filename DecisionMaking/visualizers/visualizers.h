@@ -20,7 +20,7 @@ Character* initializeCharacter(vector<Crumb>* crumbs, Texture* texture);
 
 Texture* initializeMonsterTexture();
 
-Character* initializeMonster(vector<Crumb>* crumbs, Texture* texture);
+Character* initializeMonster(vector<Crumb>* crumbs, Texture* texture, const Location& start = Location(14, 14));
 
 RenderTexture* generateLevelTexture(const Level& level);
 
@@ -2,30 +2,29 @@
 #define GRAPH_H
 
 #include <vector>
-#include <unordered_map>
-#include "../id/id.h"
+#include <memory>
 #include "../level/location.h"
 
 using namespace std;
 
 namespace graph {
 
-    /** Represents a general graph vertex. */
+    /** Represents a general graph vertex (a dense index into its graph). */
     class Vertex
     {
         private:
-        /** Unique ID for vertex. */
-        ID id;
+        /** Dense index of the vertex, in [0, graph size). */
+        int id;
 
         public:
-        /** Default constructor for vertex. */
-        Vertex();
+        /** Default constructor for vertex (invalid until assigned). */
+        inline Vertex() : id(-1) {}
 
-        /** Returns the vertex's ID (as an int). */
-        int getID() const;
+        /** Constructs a vertex with the given dense index. */
+        inline Vertex(int id) : id(id) {}
 
-        /** This is very dangerous, but hacking my way to make things work. */
-        void setID(int id);
+        /** Returns the vertex's ID (as an int). */
+        inline int getID() const { return id; }
     };
 
     /** Represents a directed weighted graph edge. */
@@ -33,9 +32,6 @@ namespace graph {
     {
 
         private:
-        /** Non-negative weight of this edge. */
-        float weight;
-
         /** Non-negative cost of traversing this edge. */
         float cost;
 
@@ -47,15 +43,15 @@ namespace graph {
 
         public:
         /** Constructs an Edge with all its fields. */
-        Edge(float w, float c, Vertex f, Vertex t);
+        inline Edge(float c, Vertex f, Vertex t) : cost(c), from(f), to(t) {}
 
         // Getters.
-        float getCost() const;
-        Vertex getFromVertex() const;
-        Vertex getToVertex() const;
+        inline float getCost() const { return cost; }
+        inline Vertex getFromVertex() const { return from; }
+        inline Vertex getToVertex() const { return to; }
     };
 
-    /** Represents node in graph (location, vertex, edges). */
+    /** Represents node in graph (location and vertex). Edges live in the graph itself. */
     class GraphNode
     {
 
@@ -67,78 +63,210 @@ namespace graph {
         /** Represents vertex in graph. */
         Vertex vertex;
 
-        /** Represents outgoing edges associated with vertex in graph. */
-        vector<Edge> edges;
-
         public:
 
         /** Constructs a GraphNode with all of its fields. */
-        GraphNode(const Location& location, const Vertex& vertex, const vector<Edge>& edges);
+        inline GraphNode(const Location& location, const Vertex& vertex) : location(location), vertex(vertex) {}
 
         /** Getters. */
-        Vertex getVertex() const;
-        Location getLocation() const;
-        vector<Edge> getEdges() const;
+        inline Vertex getVertex() const { return vertex; }
+        inline Location getLocation() const { return location; }
+    };
+
+    /**
+     * Non-allocating view over the outgoing edges of one vertex. It only points into the
+     * compressed sparse row arrays of its graph, so it is valid as long as the graph is.
+     */
+    class EdgeRange
+    {
+        private:
+        /** Vertex the edges start at. */
+        int from;
+
+        /** First target and cost of the vertex's edges. */
+        const int* targets;
+        const float* costs;
+
+        /** Number of outgoing edges. */
+        int count;
+
+        public:
 
-        /** Setters. */
-        void setEdges(const vector<Edge>& edges); // TODO: This is dangerous but I am hacking...
-        void appendEdges(const vector<Edge>& edges); // TODO: This is dangerous but I am hacking...
+        /** Iterates the edges, building each (small) Edge on the fly. */
+        class iterator
+        {
+            private:
+            const EdgeRange* range;
+            int i;
 
+            public:
+            inline iterator(const EdgeRange* range, int i) : range(range), i(i) {}
+            inline Edge operator*() const { return (*range)[i]; }
+            inline iterator& operator++() { i++; return *this; }
+            inline bool operator!=(const iterator& other) const { return i != other.i; }
+        };
+
+        /** Constructs a range with all its fields. */
+        inline EdgeRange(int from, const int* targets, const float* costs, int count) :
+            from(from), targets(targets), costs(costs), count(count) {}
+
+        /** Returns the i-th outgoing edge. */
+        inline Edge operator[](int i) const { return Edge(costs[i], Vertex(from), Vertex(targets[i])); }
+
+        /** Returns the dense index of the i-th edge's end vertex. */
+        inline int target(int i) const { return targets[i]; }
+
+        /** Returns the cost of the i-th edge. */
+        inline float cost(int i) const { return costs[i]; }
+
+        /** Getters. */
+        inline int size() const { return count; }
+        inline bool isEmpty() const { return count == 0; }
+        inline iterator begin() const { return iterator(this, 0); }
+        inline iterator end() const { return iterator(this, count); }
     };
 
-    /** Represents a tile directed weighted graph. */
+    /**
+     * Represents a tile directed weighted graph stored in compressed sparse row (CSR) form.
+     * Every tile (row, col) is the vertex with dense index row * cols + col, so localizing
+     * and quantizing are arithmetic, and the outgoing edges of vertex v are the entries
+     * offsets[v] to offsets[v + 1] of the contiguous targets and costs arrays.
+     */
     class Graph
     {
         private:
 
-        /** Index into map given a vertex's unique id and return associated GraphNode. */
-        unordered_map<int, GraphNode> nodes; // Also called quantizer.
-
-        /** Index into map given a location and return associated GraphNode. */
-        unordered_map<Location, GraphNode> localizer;
-
         /** Number of rows to represent graph. */
         int rows;
 
         /** Number of columns to represent graph. */
         int cols;
 
+        /** Start of each vertex's edges in targets and costs (size rows * cols + 1). */
+        vector<int> offsets;
+
+        /** Dense index of the end vertex of every edge, grouped by start vertex. */
+        vector<int> targets;
+
+        /** Cost of every edge, parallel to targets. */
+        vector<float> costs;
+
+        /** Largest edge cost if every cost is a non-negative integer, -1 otherwise. */
+        int maxIntegerCost;
+
         public:
 
-        /** Constructs a new graph initializing all its fields given the map of edges.*/
-        Graph(int rows, int cols, const unordered_map<int, GraphNode>& nodes);
+        /** Constructs a new graph initializing all its fields from CSR arrays. */
+        Graph(int rows, int cols, const vector<int>& offsets, const vector<int>& targets, const vector<float>& costs);
 
-        /** Copy constructor. */
-        Graph(const Graph& graph);
+        /** Returns the list of outgoing edges from the given vertex (does not allocate). */
+        inline EdgeRange getOutgoingEdges(int of) const {
+            int first = offsets[of];
+            return EdgeRange(of, targets.data() + first, costs.data() + first, offsets[of + 1] - first);
+        }
 
-        /** Returns the list of outgoing edges from the given vertex. */
-        inline vector<Edge> getOutgoingEdges(const Vertex& of) const {
-            return nodes.at(of.getID()).getEdges();
+        /** Returns the list of outgoing edges from the given vertex (does not allocate). */
+        inline EdgeRange getOutgoingEdges(const Vertex& of) const {
+            return getOutgoingEdges(of.getID());
         }
 
+        /** Returns the GraphNode of the given vertex. */
         inline GraphNode getNode(const graph::Vertex& vertex) const {
-            return nodes.at(vertex.getID());
+            return GraphNode(localize(vertex), vertex);
+        }
+
+        /** Maps vertex in graph to location in level. */
+        inline Location localize(int vertex) const {
+            return Location(vertex / cols, vertex % cols);
         }
 
         /** Maps vertex in graph to location in level. */
         inline Location localize(const graph::Vertex& vertex) const {
-            return nodes.at(vertex.getID()).getLocation();
+            return localize(vertex.getID());
+        }
+
+        /** Maps location in level to the dense index of its vertex. */
+        inline int index(const Location& location) const {
+            return location.x * cols + location.y;
         }
 
         /** Maps location in level to GraphNode in graph. */
         inline GraphNode quantize(const Location& location) const {
-            return localizer.at(location);
+            return GraphNode(location, Vertex(index(location)));
+        }
+
+        /** Returns true if the location is a tile of the graph. */
+        inline bool contains(const Location& location) const {
+            return location.x >= 0 && location.x < rows && location.y >= 0 && location.y < cols;
         }
 
+        /** Returns the number of vertices. */
+        inline int size() const { return rows * cols; }
+
+        /** Returns the number of (directed) edges. */
+        inline int getEdgeCount() const { return targets.size(); }
+
+        /** Returns the largest edge cost if every cost is a non-negative integer, -1 otherwise. */
+        inline int getMaxIntegerCost() const { return maxIntegerCost; }
+
+        /** Returns the bytes of heap the graph holds. */
+        inline size_t getHeapBytes() const {
+            return offsets.capacity() * sizeof(int) + targets.capacity() * sizeof(int) + costs.capacity() * sizeof(float);
+        }
+
+        /** Returns the graph with every edge reversed (keeping its cost), as backward searches need. */
+        inline Graph transpose() const { return transpose(*this); }
+
+        /** Returns graph (a Graph or GridGraph) with every edge reversed as a Graph. */
+        template <class G>
+        static Graph transpose(const G& graph);
+
         /** Getters. */
-        int getRows();
-        int getCols();
+        int getRows() const;
+        int getCols() const;
 
         /** Prints IDs of verticies in graph. */
-        void print();
+        void print() const;
 
-        void printy();
+        void printy() const;
     };
+
+    template <class G>
+    inline Graph Graph::transpose(const G& graph) {
+
+        // Count the edges into each vertex, then place every edge under its target (a counting sort).
+        vector<int> offsets(graph.size() + 1, 0);
+        for (int vertex = 0; vertex < graph.size(); vertex++) {
+            auto edges = graph.getOutgoingEdges(vertex);
+            for (int i = 0; i < edges.size(); i++) { offsets[edges.target(i) + 1]++; }
+        }
+        for (int vertex = 0; vertex < graph.size(); vertex++) { offsets[vertex + 1] += offsets[vertex]; }
+
+        vector<int> targets(offsets.back());
+        vector<float> costs(offsets.back());
+        vector<int> next(offsets.begin(), offsets.end() - 1);
+        for (int vertex = 0; vertex < graph.size(); vertex++) {
+            auto edges = graph.getOutgoingEdges(vertex);
+            for (int i = 0; i < edges.size(); i++) {
+                int slot = next[edges.target(i)]++;
+                targets[slot] = vertex;
+                costs[slot] = edges.cost(i);
+            }
+        }
+        return Graph(graph.getRows(), graph.getCols(), offsets, targets, costs);
+    }
+
+    /**
+     * Reference counted handle to an immutable Graph. Copying a handle never copies the graph,
+     * and since the graph cannot change through it, one graph may be searched from many threads.
+     */
+    typedef shared_ptr<const Graph> GraphHandle;
+
+    /** Moves graph into a new handle. */
+    inline GraphHandle makeGraphHandle(Graph graph) { return make_shared<const Graph>(move(graph)); }
+
+    /** Returns the vertices of graph with an outgoing edge, the cells an agent can stand on. */
+    vector<int> openCells(const Graph& graph);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -36,4 +36,10 @@ const float RADIUS_OF_DECELERATION = 25.f;
 const float PATH_OFFSET = 1;
 const float PREDICTION_TIME = 0.15;
 
+const int CLUSTER_SIZE = 10;
+const int REFINED_SEGMENTS_PER_FRAME = 1;
+const int LANDMARKS = 8;
+const float SUBOPTIMALITY_BOUND = 1.5;
+const int PATH_CACHE_CAPACITY = 1 << 16;
+
 #endif
\ No newline at end of file
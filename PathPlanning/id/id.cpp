@@ -1,8 +1,7 @@
 #include "id.h"
 
 ID::ID() {
-	id = count + 1;
-	count += 1;
+	id = count.fetch_add(1) + 1;
 }
 
 int ID::getID() const {
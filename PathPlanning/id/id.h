@@ -1,11 +1,13 @@
 #ifndef ID_H
 #define ID_H
 
-/** Represents a unique ID. */
+#include <atomic>
+
+/** Represents a unique ID (safe to construct from any thread). */
 class ID
 {
 	private:
-	static int count;
+	static std::atomic<int> count;
 	int id;
 
 	public:
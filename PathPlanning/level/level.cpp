@@ -21,15 +21,11 @@ float mapConnectionCost(ConnectionCost cost) {
     }
 }
 void Connections::setFalse() {
-    for (int i = 0; i < 4; i++) {
-        directions[i] = false;
-    }
+    directions = 0;
 }
 
 void Connections::setTrue() {
-    for (int i = 0; i < 4; i++) {
-        directions[i] = true;
-    }
+    directions = 0x0F;
 }
 
 LevelCell::LevelCell(const Location& location, bool inLevel) {
@@ -85,20 +81,13 @@ Level::Level(const Level& level) {
     cells = level.cells;
 }
 
-Level::Level(int w, int h) {
+Level::Level(int w, int h) : cells(h, w) {
     cols = w;
     rows = h;
-    for (int r = 0; r < rows; r++) {
-        vector<Connections> v;
-        for (int c = 0; c < cols; c++) {
-            v.push_back(Connections());
-        }
-        cells.push_back(v);
-    }
 }
 
 void Level::startAt(Location location) {
-    cells[location.x][location.y].inLevel = true;
+    cells.setInLevel(location.x, location.y, true);
 }
 
 int Level::getDirIdx(Location o, int x, int y) const {
@@ -191,9 +180,9 @@ Location Level::makeConnections(Location location) {
 
         // Make sure it is not a cell that already is in the level.
         if (canPlaceCorridor(nx, ny) && canPlaceCorridorDeep(location, nx, ny, dirIdx)) {
-            cells[x][y].directions[dirIdx] = true;
-            cells[nx][ny].inLevel = true;
-            cells[nx][ny].directions[fromDirIdx] = true;
+            cells.setDirection(x, y, dirIdx, true);
+            cells.setInLevel(nx, ny, true);
+            cells.setDirection(nx, ny, fromDirIdx, true);
             return Location(nx, ny);
         }
 
@@ -249,139 +238,44 @@ vector<vector<LevelCell>> Level::toSFML() {
 }
 
 Graph levelToGraph(const Level& level) {
-    unordered_map<int, GraphNode> nodes;
-    unordered_map<Location, GraphNode> nodesByLocation;
-
-    // Init nodes (without edges).
-    for (int i = 0; i < level.rows; i++) {
-        for (int j = 0; j < level.cols; j++) {
-            Location location(i, j);
-            graph::Vertex vertex;
-            vector<Edge> edges;
-            GraphNode node = GraphNode(location, vertex, edges);
-            nodes.insert({ node.getVertex().getID(), node });
-            nodesByLocation.insert({ node.getLocation(), node });
-        }
-    }
-
-    // Init nodes' edges.
-    for (int i = 0; i < level.rows; i++) {
-        for (int j = 0; j < level.cols; j++) {
-
-            // Connection not in level has no edges.
-            Connections connections = level.cells[i][j];
-            if (!connections.inLevel) { continue; }
-
-            // Get self and list of edges to append.
-            GraphNode node = nodesByLocation.at(Location(i, j));
-            vector<Edge> edges;
-
-            // Connection in level has edges (for those that are marked as true).
-            auto directions = connections.directions;
-            for (int k = 0; k < 4; k++) {
-                if (!directions[k]) { continue; }
-                int nx = i + level.NEIGHBORS[k][0];
-                int ny = j + level.NEIGHBORS[k][1];
-                if (!level.inBounds(nx, ny)) { continue; }
-                if (!level.cells[nx][ny].inLevel) { continue; }
-
-                // Add edge to neighbor.
-                GraphNode neighborNode = nodesByLocation.at(Location(nx, ny));
-                edges.push_back(Edge(1.0, 1.0, node.getVertex(), neighborNode.getVertex()));
-            }
-
-            // Update node and its reference in the nodes.
-            node.appendEdges(edges);
-            auto iteratorNodes = nodes.find(node.getVertex().getID());
-            iteratorNodes->second = node;
-        }
-    }
-
-    // // Print out the number of verticies.
-    // int inLevelCount = 0;
-    // int directionsCount = 0;
-    // for (int i = 0; i < level.rows; i++) {
-    //     for (int j = 0; j < level.cols; j++) {
-    //         if (level.cells[i][j].inLevel) {
-    //             inLevelCount += 1;
-    //             for (int k = 0; k < 4; k++) {
-    //                 if (level.cells[i][j].directions[k]) {
-    //                     directionsCount += 1;
-    //                 }
-    //             }
-    //         }
-    //         Location(i, j);
-    //     }
-    // }
-    // cout << "allLevelCount = " << level.rows * level.cols << endl;
-    // cout << "inLevelCount = " << inLevelCount << endl;
-    // cout << "directionsCount = " << directionsCount << endl;
-
-    // int edgesCount = 0;
-    // for (auto const& node : nodes) {
-    //     edgesCount += node.second.getEdges().size();
-    // }
-    // cout << "edgesCount = " << edgesCount << endl;
-
-
-    // Print out the number of edges.
-
-    // Return the graph.
-    return Graph(level.rows, level.cols, nodes);
+    return levelToGraph(level, false);
 }
 
 Graph levelToGraph(const Level& level, bool flag) {
-    unordered_map<int, GraphNode> nodes;
-    unordered_map<Location, GraphNode> nodesByLocation;
-
-    // Init nodes (without edges).
-    for (int i = 0; i < level.rows; i++) {
-        for (int j = 0; j < level.cols; j++) {
-            Location location(i, j);
-            graph::Vertex vertex;
-            vector<Edge> edges;
-            GraphNode node = GraphNode(location, vertex, edges);
-            nodes.insert({ node.getVertex().getID(), node });
-            nodesByLocation.insert({ node.getLocation(), node });
-        }
-    }
-
-    // Init nodes' edges.
+    vector<int> offsets;
+    vector<int> targets;
+    vector<float> costs;
+    offsets.reserve(level.rows * level.cols + 1);
+    targets.reserve(level.rows * level.cols * 4);
+    costs.reserve(level.rows * level.cols * 4);
+
+    // Vertices are numbered row-major, so each cell's edges are appended in vertex order.
     for (int i = 0; i < level.rows; i++) {
         for (int j = 0; j < level.cols; j++) {
+            offsets.push_back(targets.size());
 
             // Connection not in level has no edges.
-            Connections connections = level.cells[i][j];
+            const Connections& connections = level.cells[i][j];
             if (!connections.inLevel) { continue; }
 
-            // Get self and list of edges to append.
-            GraphNode node = nodesByLocation.at(Location(i, j));
-            vector<Edge> edges;
-
             // Connection in level has edges (for those that are marked as true).
-            auto directions = connections.directions;
             for (int k = 0; k < 4; k++) {
-                if (!directions[k]) { continue; }
+                if (!connections.hasDirection(k)) { continue; }
                 int nx = i + level.NEIGHBORS[k][0];
                 int ny = j + level.NEIGHBORS[k][1];
                 if (!level.inBounds(nx, ny)) { continue; }
                 if (!level.cells[nx][ny].inLevel) { continue; }
 
-                // Add edge to neighbor.
-                GraphNode neighborNode = nodesByLocation.at(Location(nx, ny));
-                int cost = mapConnectionCost(level.cells[nx][ny].cost);
-                edges.push_back(Edge(1.0, cost, node.getVertex(), neighborNode.getVertex()));
+                // Add edge to neighbor (weighted by the neighbor's cost if flagged).
+                targets.push_back(nx * level.cols + ny);
+                costs.push_back(flag ? mapConnectionCost(level.cells[nx][ny].cost) : 1.0);
             }
-
-            // Update node and its reference in the nodes.
-            node.appendEdges(edges);
-            auto iteratorNodes = nodes.find(node.getVertex().getID());
-            iteratorNodes->second = node;
         }
     }
+    offsets.push_back(targets.size());
 
     // Return the graph.
-    return Graph(level.rows, level.cols, nodes);
+    return Graph(level.rows, level.cols, offsets, targets, costs);
 }
 
 Level generateCharacterLevel() {
@@ -391,81 +285,111 @@ Level generateCharacterLevel() {
     // Cells default to in level, normal cost, and have full connections.
     for (int i = 0; i < z; i++) {
         for (int j = 0; j < z; j++) {
-            level.cells[i][j].inLevel = true;
-            level.cells[i][j].cost = normal;
-            level.cells[i][j].setTrue();
+            level.cells.setInLevel(i, j, true);
+            level.cells.setCost(i, j, normal);
+            level.cells.setDirections(i, j, true);
         }
     }
 
     // Initialize borders.
     for (int i = 0; i < z; i++) {
-        level.cells[0][i].cost = wall; // Top row.
-        level.cells[i][z / 2].cost = wall; // Middle row.
-        level.cells[z - 1][i].cost = wall; // Bottom row.
-        level.cells[i][0].cost = wall; // First column.
-        level.cells[z / 2][i].cost = wall; // Middle column.
-        level.cells[i][z - 1].cost = wall; // Last row.
-
-        level.cells[0][i].setFalse(); // Top row.
-        level.cells[i][z / 2].setFalse(); // Middle row.
-        level.cells[z - 1][i].setFalse(); // Bottom row.
-        level.cells[i][0].setFalse(); // First column.
-        level.cells[z / 2][i].setFalse(); // Middle column.
-        level.cells[i][z - 1].setFalse(); // Last row.
+        level.cells.setCost(0, i, wall); // Top row.
+        level.cells.setCost(i, z / 2, wall); // Middle row.
+        level.cells.setCost(z - 1, i, wall); // Bottom row.
+        level.cells.setCost(i, 0, wall); // First column.
+        level.cells.setCost(z / 2, i, wall); // Middle column.
+        level.cells.setCost(i, z - 1, wall); // Last row.
+
+        level.cells.setDirections(0, i, false); // Top row.
+        level.cells.setDirections(i, z / 2, false); // Middle row.
+        level.cells.setDirections(z - 1, i, false); // Bottom row.
+        level.cells.setDirections(i, 0, false); // First column.
+        level.cells.setDirections(z / 2, i, false); // Middle column.
+        level.cells.setDirections(i, z - 1, false); // Last row.
     }
 
     // Open gaps in borders.
-    level.cells[10][11].cost = normal;
-    level.cells[10][11].setTrue();
+    level.cells.setCost(10, 11, normal);
+    level.cells.setDirections(10, 11, true);
 
-    level.cells[11][10].cost = normal;
-    level.cells[11][10].setTrue();
+    level.cells.setCost(11, 10, normal);
+    level.cells.setDirections(11, 10, true);
 
-    level.cells[z - 2][11].cost = normal;
-    level.cells[z - 2][11].setTrue();
+    level.cells.setCost(z - 2, 11, normal);
+    level.cells.setDirections(z - 2, 11, true);
 
-    level.cells[11][z - 2].cost = normal;
-    level.cells[11][z - 2].setTrue();
+    level.cells.setCost(11, z - 2, normal);
+    level.cells.setDirections(11, z - 2, true);
 
 
     // Add obstacle to top left room.
     for (int i = 2; i < 6; i++) {
-        level.cells[i][5].cost = wall;
-        level.cells[5][i].cost = wall;
+        level.cells.setCost(i, 5, wall);
+        level.cells.setCost(5, i, wall);
     }
 
     // Add patches in top left room.
     for (int i = 2; i < 6; i++) {
-        level.cells[i][8].cost = pricey;
-        level.cells[i][9].cost = pricey;
-        level.cells[8][i].cost = expensive;
-        level.cells[9][i].cost = expensive;
+        level.cells.setCost(i, 8, pricey);
+        level.cells.setCost(i, 9, pricey);
+        level.cells.setCost(8, i, expensive);
+        level.cells.setCost(9, i, expensive);
     }
 
     // Add patches in top right room.
     for (int i = 12; i < 19; i++) {
-        level.cells[i][6].cost = expensive;
-        level.cells[i][7].cost = expensive;
-        level.cells[i][8].cost = expensive;
+        level.cells.setCost(i, 6, expensive);
+        level.cells.setCost(i, 7, expensive);
+        level.cells.setCost(i, 8, expensive);
     }
     for (int i = 15; i < 20; i++) {
-        level.cells[i][10].cost = expensive;
+        level.cells.setCost(i, 10, expensive);
     }
 
     // Add patches for bottom left room.
     for (int i = 6; i < 9; i++) {
-        level.cells[i][12].cost = pricey;
-        level.cells[i][13].cost = pricey;
+        level.cells.setCost(i, 12, pricey);
+        level.cells.setCost(i, 13, pricey);
     }
     for (int i = 6; i < 11; i++) {
-        level.cells[i][15].cost = pricey;
-        level.cells[i][16].cost = pricey;
+        level.cells.setCost(i, 15, pricey);
+        level.cells.setCost(i, 16, pricey);
     }
 
     // Add obstacles to bottom right room.
-    level.cells[17][z - 2].cost = wall;
-    level.cells[17][z - 2].setFalse();
-    level.cells[z - 2][17].cost = wall;
-    level.cells[z - 2][17].setFalse();
+    level.cells.setCost(17, z - 2, wall);
+    level.cells.setDirections(17, z - 2, false);
+    level.cells.setCost(z - 2, 17, wall);
+    level.cells.setDirections(z - 2, 17, false);
     return level;
-}
\ No newline at end of file
+}
+Level generateOpenLevel(int w, int h) {
+    Level level(w, h);
+
+    // Cells inside the border are in level, normal cost, and have full connections.
+    for (int i = 1; i < level.rows - 1; i++) {
+        for (int j = 1; j < level.cols - 1; j++) {
+            level.cells.setInLevel(i, j, true);
+            level.cells.setCost(i, j, normal);
+            level.cells.setDirections(i, j, true);
+        }
+    }
+
+    // Add 2x2 pillars every ten cells.
+    for (int i = 5; i < level.rows - 3; i += 10) {
+        for (int j = 5; j < level.cols - 3; j += 10) {
+            level.cells.setInLevel(i, j, false);
+            level.cells.setInLevel(i, j + 1, false);
+            level.cells.setInLevel(i + 1, j, false);
+            level.cells.setInLevel(i + 1, j + 1, false);
+        }
+    }
+
+    // Add an expensive patch in the middle.
+    for (int i = level.rows / 2 - 3; i < level.rows / 2 + 3; i++) {
+        for (int j = level.cols / 2 - 3; j < level.cols / 2 + 3; j++) {
+            if (level.cells[i][j].inLevel) { level.cells.setCost(i, j, expensive); }
+        }
+    }
+    return level;
+}
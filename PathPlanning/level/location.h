@@ -13,7 +13,7 @@ class Location
     public:
 
     /** Constructs a location with all its fields. */
-    Location(int a, int b);
+    inline Location(int a, int b) : x(a), y(b) {}
 
     /** X coordinate in level. */
     int x;
@@ -43,10 +43,4 @@ namespace std {
     };
 }
 
-/** Returns mapping of position in SFML render window to location in graph. */
-Location mapToLevel(int dimension, float mappingScale, const Vector2f& vector);
-
-/** Returns mapping of location in graph to position in SFML render window. */
-Vector2f mapToWindow(float mappingScale, const Location& location);
-
 #endif
\ No newline at end of file
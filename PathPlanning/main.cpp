@@ -7,6 +7,7 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <chrono>
+#include <thread>
 #include <iostream>
 #include "debug/debug.h"
 #include "debug/breadcrumbs.h"
@@ -20,18 +21,35 @@
 #include "steering/steering.h"
 #include "steering/steeringoutput.h"
 #include "graph/graph.h"
+#include "graph/gridgraph.h"
 #include "level/level.h"
+#include "level/transform.h"
 #include "maze/maze.h"
 #include "search/search.h"
 #include "search/dijsktra.h"
 #include "search/a*.h"
+#include "search/jps.h"
+#include "search/clustergraph.h"
+#include "search/hpa.h"
+#include "search/treeoracle.h"
+#include "search/corridorgraph.h"
+#include "search/landmarks.h"
+#include "search/bidirectional.h"
+#include "search/boundedsearch.h"
+#include "search/searchpool.h"
+#include "search/pathcache.h"
+#include "search/dstarlite.h"
+#include "search/flowfield.h"
+#include "search/slicedsearch.h"
+#include "search/pathservice.h"
+#include "search/searchcontext.h"
 
 using namespace std;
 using namespace chrono;
 using namespace sf;
 
 /** Start unique IDs at 0. */
-int ID::count = 0;
+atomic<int> ID::count(0);
 
 /** Size of each tile in the Maze. */
 float MAZE_X = 0.f;
@@ -65,35 +83,98 @@ void Visualize(const Maze& maze, const Path& path) {
 	}
 }
 
+/** Returns the bounded search mode of a bounded A* algorithm. */
+BoundedMode boundedMode(Algorithm algorithm) {
+	return algorithm == A_STAR_FOCAL ? FOCAL_SEARCH : algorithm == A_STAR_OPTIMISTIC ? OPTIMISTIC_SEARCH : WEIGHTED_SEARCH;
+}
+
 /** Switches over given algorithm for a maze path finding visualization. */
 void VisualizeSwitch(Algorithm algorithm, const Maze& maze, const Location& start, const Location& end) {
+	const GridGraph& grid = maze.getGridGraph();
+	SearchContext context(grid.size());
+	Path path;
+
+	// A perfect maze has exactly one path between two cells, which its tree oracle reads off without searching.
+	// Only plain Dijkstra and A* are replaced by it, as the other algorithms are visualized for their own paths.
+	const TreeOracle* oracle = maze.getTreeOracle();
+	bool plain = algorithm == DIJKSTRA || algorithm == A_STAR_H1 || algorithm == A_STAR_H2 || algorithm == A_STAR_CUSTOM;
+	if (oracle != nullptr && plain) {
+		cout << "Maze is a tree, reading path from its tree oracle..." << endl;
+		oracle->getPath(start, end, path);
+		Visualize(maze, path);
+		return;
+	}
+
 	cout << "Searching maze..." << endl;
 	switch (algorithm) {
 		case DIJKSTRA:
 			{
-				Dijkstra search(maze.getGraph(), start, end);
-				Path path = search.search();
+				Dijkstra::search(grid, start, end, context, path);
 				Visualize(maze, path);
 				break;
 			}
 		case A_STAR_H1:
 			{
-				AStar search(maze.getGraph(), start, end, ManhattanHeuristic(end));
-				Path path = search.search();
+				AStar::search(grid, start, end, ManhattanHeuristic(end), context, path);
 				Visualize(maze, path);
 				break;
 			}
 		case A_STAR_H2:
 			{
-				AStar search(maze.getGraph(), start, end, EuclideanHeuristic(end));
-				Path path = search.search();
+				AStar::search(grid, start, end, EuclideanHeuristic(end), context, path);
 				Visualize(maze, path);
 				break;
 			}
 		case A_STAR_CUSTOM:
 			{
-				AStar search(maze.getGraph(), start, end, CustomHeuristic(end));
-				Path path = search.search();
+				AStar::search(grid, start, end, CustomHeuristic(end), context, path);
+				Visualize(maze, path);
+				break;
+			}
+		case JUMP_POINT:
+			{
+				JumpPointSearch::search(grid, start, end, ManhattanHeuristic(end), context, path);
+				Visualize(maze, path);
+				break;
+			}
+		case HIERARCHICAL:
+			{
+				ClusterGraph clusters(grid, CLUSTER_SIZE);
+				HierarchicalContext hierarchicalContext(clusters);
+				HierarchicalPath plan;
+				HierarchicalSearch::search(clusters, start, end, ManhattanHeuristic(end), hierarchicalContext, plan);
+				HierarchicalSearch::refine(clusters, hierarchicalContext, plan, plan.getWaypoints().size());
+				Visualize(maze, plan.getPath());
+				break;
+			}
+		case A_STAR_LANDMARKS:
+			{
+				Landmarks landmarks(grid, LANDMARKS);
+				AStar::search(grid, start, end, LandmarkHeuristic(landmarks, end), context, path);
+				Visualize(maze, path);
+				break;
+			}
+		case BIDIRECTIONAL_DIJKSTRA:
+			{
+				SearchContext backward(grid.size());
+				BidirectionalSearch::search(grid, Graph::transpose(grid), start, end, context, backward, path);
+				Visualize(maze, path);
+				break;
+			}
+		case BIDIRECTIONAL_A_STAR:
+			{
+				SearchContext backward(grid.size());
+				BidirectionalSearch::search(grid, Graph::transpose(grid), start, end, ManhattanHeuristic(end), ManhattanHeuristic(start), context,
+					backward, path);
+				Visualize(maze, path);
+				break;
+			}
+		case A_STAR_WEIGHTED:
+		case A_STAR_OPTIMISTIC:
+		case A_STAR_FOCAL:
+			{
+				BoundedSearch::search(grid, start, end, ManhattanHeuristic(end), SUBOPTIMALITY_BOUND, boundedMode(algorithm), context, path);
+				cout << "Path cost is within " << path.bound << " times the optimal cost" << endl;
 				Visualize(maze, path);
 				break;
 			}
@@ -153,37 +234,65 @@ void HugeGraphVisualizer(Algorithm algorithm) {
 	VisualizeSwitch(algorithm, maze, start, end);
 }
 
-/** Returns path from start to end in the graph. */
-Path getPath(float mappingScale, Algorithm algorithm, const Level& level, const Graph& graph, const Vector2f& start_, const Vector2f& end_) {
-	Location start = mapToLevel(level.rows, mappingScale, start_);
-	Location end = mapToLevel(level.rows, mappingScale, end_);
+/** Finds path from start to end in the graph into path, reusing the context. */
+void getPath(const GridTransform& transform, Algorithm algorithm, const GridGraph& graph, const Graph& reverse, const Landmarks& landmarks,
+	const Vector2f& start_, const Vector2f& end_, SearchContext& context, SearchContext& backward, Path& path) {
+	Location start = transform.toLevel(start_);
+	Location end = transform.toLevel(end_);
 	switch (algorithm) {
 		case DIJKSTRA:
 			{
-				Dijkstra search(graph, start, end);
-				return search.search();
+				Dijkstra::search(graph, start, end, context, path);
+				break;
 			}
 		case A_STAR_H1:
 			{
-				AStar search(graph, start, end, ManhattanHeuristic(end));
-				return search.search();
+				AStar::search(graph, start, end, ManhattanHeuristic(end), context, path);
+				break;
 			}
 		case A_STAR_H2:
 			{
-				AStar search(graph, start, end, EuclideanHeuristic(end));
-				return search.search();
+				AStar::search(graph, start, end, EuclideanHeuristic(end), context, path);
+				break;
 			}
 		case A_STAR_CUSTOM:
 			{
-				AStar search(graph, start, end, CustomHeuristic(end));
-				return search.search();
+				AStar::search(graph, start, end, CustomHeuristic(end), context, path);
+				break;
+			}
+		case JUMP_POINT:
+			{
+				JumpPointSearch::search(graph, start, end, ManhattanHeuristic(end), context, path);
+				break;
+			}
+		case A_STAR_LANDMARKS:
+			{
+				AStar::search(graph, start, end, LandmarkHeuristic(landmarks, end), context, path);
+				break;
+			}
+		case BIDIRECTIONAL_DIJKSTRA:
+			{
+				BidirectionalSearch::search(graph, reverse, start, end, context, backward, path);
+				break;
+			}
+		case BIDIRECTIONAL_A_STAR:
+			{
+				BidirectionalSearch::search(graph, reverse, start, end, ManhattanHeuristic(end), ManhattanHeuristic(start), context, backward, path);
+				break;
+			}
+		case A_STAR_WEIGHTED:
+		case A_STAR_OPTIMISTIC:
+		case A_STAR_FOCAL:
+			{
+				BoundedSearch::search(graph, start, end, ManhattanHeuristic(end), SUBOPTIMALITY_BOUND, boundedMode(algorithm), context, path);
+				break;
 			}
 
 		default:
 			{
 				fail("invalid algorithm choice");
-				Dijkstra search(graph, start, start);
-				return search.search();
+				Dijkstra::search(graph, start, start, context, path);
+				break;
 			}
 	}
 }
@@ -199,8 +308,8 @@ void CharacterGraphVisualizer(Algorithm algorithm) {
 	Level level = generateCharacterLevel();
 
 	cout << "Generating graph representation of level..." << endl;
-	Graph graph = levelToGraph(level, true);
-	graph.printy();
+	GridGraph graph(level, true, true);
+	GridTransform transform(level.rows, SIZE);
 
 	cout << "Generating scene assests..." << endl;
 	vector<Crumb> crumbs = vector<Crumb>();
@@ -213,7 +322,7 @@ void CharacterGraphVisualizer(Algorithm algorithm) {
 	character.texture = texture;
 	character.sprite = *(new Sprite(texture));
 	character.sprite.setScale(scale, scale);
-	Vector2f start = mapToWindow(SIZE, Location(1, 1));
+	Vector2f start = transform.toWindow(Location(1, 1));
 	Kinematic initialState;
 	initialState.position = start;
 	character.setKinematic(initialState);
@@ -234,6 +343,13 @@ void CharacterGraphVisualizer(Algorithm algorithm) {
 	levelTexture.display();
 	Sprite staticLevel(levelTexture.getTexture());
 	Path path;
+	SearchContext context(graph.size());
+	ClusterGraph clusters(graph, CLUSTER_SIZE);
+	HierarchicalContext hierarchicalContext(clusters);
+	HierarchicalPath plan;
+	Landmarks landmarks(graph, LANDMARKS);
+	Graph reverse = Graph::transpose(graph);
+	SearchContext backward(graph.size());
 	Sprite staticPath;
 	RenderTexture pathTexture;
 	pathTexture.create(SCENE_WINDOW_X, SCENE_WINDOW_Y);
@@ -241,7 +357,7 @@ void CharacterGraphVisualizer(Algorithm algorithm) {
 
 	cout << "Rendering level..." << endl;
 	SceneView sceneView(SCENE_WINDOW_X, SCENE_WINDOW_Y, SCENE_WINDOW_FR);
-	FollowPath pathFollowing(path, PATH_OFFSET, 0, PREDICTION_TIME, TIME_TO_REACH_TARGET_SPEED, RADIUS_OF_ARRIVAL, RADIUS_OF_DECELERATION, MAX_SPEED);
+	FollowPath pathFollowing(path, transform, PATH_OFFSET, 0, PREDICTION_TIME, TIME_TO_REACH_TARGET_SPEED, RADIUS_OF_ARRIVAL, RADIUS_OF_DECELERATION, MAX_SPEED);
 	bool followingPath = false;
 	bool newPathExists = false;
 	while (sceneView.scene.isOpen()) {
@@ -255,14 +371,24 @@ void CharacterGraphVisualizer(Algorithm algorithm) {
 				case Event::MouseButtonPressed:
 					if (!followingPath) {
 						cout << "\n\nGetting path..." << endl;
-						path = Path();
-						path = getPath(SIZE, algorithm, level, graph, character.getPosition(), Vector2f(mouse.getPosition(sceneView.scene)));
+
+						// Hierarchical paths are refined a few segments per frame while the character already follows them.
+						if (algorithm == HIERARCHICAL) {
+							Location end = transform.toLevel(Vector2f(mouse.getPosition(sceneView.scene)));
+							HierarchicalSearch::search(clusters, transform.toLevel(character.getPosition()), end, ManhattanHeuristic(end), hierarchicalContext, plan);
+							HierarchicalSearch::refine(clusters, hierarchicalContext, plan, REFINED_SEGMENTS_PER_FRAME);
+							path = plan.getPath();
+						}
+						else {
+							getPath(transform, algorithm, graph, reverse, landmarks, character.getPosition(), Vector2f(mouse.getPosition(sceneView.scene)), context, backward,
+								path);
+						}
 						newPathExists = true;
 						cout << "Got path." << endl;
 						path.print();
 						cout << "Explored nodes: " << path.exploredNodes << endl;
 
-						pathFollowing = FollowPath(path, PATH_OFFSET, 0, PREDICTION_TIME, TIME_TO_REACH_TARGET_SPEED, RADIUS_OF_ARRIVAL, RADIUS_OF_DECELERATION, MAX_SPEED);
+						pathFollowing.setPath(path);
 						followingPath = true;
 
 
@@ -276,9 +402,21 @@ void CharacterGraphVisualizer(Algorithm algorithm) {
 			}
 		}
 
+		// Refine more of a hierarchical path.
+		if (algorithm == HIERARCHICAL && !plan.isComplete()) {
+			HierarchicalSearch::refine(clusters, hierarchicalContext, plan, REFINED_SEGMENTS_PER_FRAME);
+			path = plan.getPath();
+			pathFollowing.extendPath(path);
+			pathSFML = path.toSFML();
+			pathTexture.clear(sf::Color{ 255,255,255,0 });
+			for (const auto& element : pathSFML) { pathTexture.draw(element); }
+			pathTexture.display();
+			staticPath = Sprite(pathTexture.getTexture());
+		}
+
 		// Re-render scene.
-		if (!path.isEmpty()) {
-			if (mapToLevel(MAZE_X, SIZE, character.getPosition()) == path.getLast()) {
+		if (!path.isEmpty() && (algorithm != HIERARCHICAL || plan.isComplete())) {
+			if (transform.toLevel(character.getPosition()) == path.getLast()) {
 				followingPath = false;
 			}
 		}
@@ -297,97 +435,188 @@ void CharacterGraphVisualizer(Algorithm algorithm) {
 	}
 }
 
+/** Returns the average runtime of iterations runs of search (called with the run's index) in Duration units. */
+template <class Duration = chrono::microseconds, class F>
+long long averageTime(int iterations, const F& search) {
+	auto startTime = steady_clock::now();
+	for (int i = 0; i < iterations; i++) { search(i); }
+	auto endTime = steady_clock::now();
+	return duration_cast<Duration>(endTime - startTime).count() / iterations;
+}
+
+/** Runs search iterations times, printing the runtime and explored nodes of path after each run and their averages to console. */
+template <class F>
+void printRuns(int iterations, const Path& path, const F& search) {
+	float average = 0;
+	float avgExplored = 0;
+	for (int i = 0; i < iterations; i++) {
+		auto startTime = steady_clock::now();
+		search();
+		auto endTime = steady_clock::now();
+		auto elapsed = duration_cast<chrono::milliseconds>(endTime - startTime).count();
+		cout << "\tIteration " << i << ": " << elapsed << " ms" << endl;
+		cout << "\t             " << path.exploredNodes << " nodes explored";
+		if (path.bound > 0) { cout << ", within " << path.bound << " of optimal"; }
+		cout << endl << endl;
+		average += elapsed;
+		avgExplored += path.exploredNodes;
+	}
+	average /= iterations;
+	avgExplored /= iterations;
+	cout << "Average runtime over " << iterations << " iterations: " << average << " ms" << endl;
+	cout << "Average memory over " << iterations << " iterations: " << (int)avgExplored << " nodes explored" << endl << endl;
+}
+
+/** Returns the corner cell opposite (1, 1) of a rows x cols level, moved left off walls, where the corner to corner tests end. */
+template <class G>
+Location farCorner(const G& graph, int rows, int cols) {
+	Location end(rows - 2, cols - 2);
+	while (graph.getOutgoingEdges(graph.index(end)).isEmpty()) { end.y--; }
+	return end;
+}
+
+/** Returns a random one of the cells of graph. */
+Location randomCell(const Graph& graph, const vector<int>& cells) {
+	return graph.localize(cells[rand() % cells.size()]);
+}
+
+/** Returns count queries between random open cells of graph, as start and end locations. */
+vector<pair<Location, Location>> randomQueries(const Graph& graph, int count) {
+	vector<int> cells = openCells(graph);
+	vector<pair<Location, Location>> queries;
+	for (int i = 0; i < count; i++) {
+		Location start = randomCell(graph, cells);
+		queries.push_back(make_pair(start, randomCell(graph, cells)));
+	}
+	return queries;
+}
+
+/** Prints runtimes of jump point search to console. */
+void JumpPointTester(int iterations, const GridGraph& graph, const Location& start, const Location& end) {
+	cout << AlgorithmStrings[4] << " Runtime: " << endl;
+	ManhattanHeuristic heuristic(end);
+	SearchContext context(graph.size());
+	Path path;
+	printRuns(iterations, path, [&] { JumpPointSearch::search(graph, start, end, heuristic, context, path); });
+}
+
+/** Prints runtimes of hierarchical A* (search and full refinement) to console. */
+void HierarchicalTester(int iterations, const GridGraph& graph, const Location& start, const Location& end) {
+	cout << AlgorithmStrings[5] << " Runtime: " << endl;
+	ManhattanHeuristic heuristic(end);
+	ClusterGraph clusters(graph, CLUSTER_SIZE);
+	HierarchicalContext context(clusters);
+	HierarchicalPath plan;
+	printRuns(iterations, plan.getPath(), [&] {
+		HierarchicalSearch::search(clusters, start, end, heuristic, context, plan);
+		HierarchicalSearch::refine(clusters, context, plan, plan.getWaypoints().size());
+	});
+}
+
+/** Prints the landmark build time and runtimes of A* with the landmark heuristic to console. */
+template <class G>
+void LandmarkTester(int iterations, const G& graph, const Location& start, const Location& end) {
+	auto startTime = steady_clock::now();
+	Landmarks landmarks(graph, LANDMARKS);
+	auto endTime = steady_clock::now();
+	cout << AlgorithmStrings[6] << " Runtime (" << landmarks.size() << " landmarks built in ";
+	cout << duration_cast<chrono::milliseconds>(endTime - startTime).count() << " ms): " << endl;
+	LandmarkHeuristic heuristic(landmarks, end);
+	SearchContext context(graph.size());
+	Path path;
+	printRuns(iterations, path, [&] { AStar::search(graph, start, end, heuristic, context, path); });
+}
+
+/** Prints runtimes of bidirectional Dijkstra (or A* with heuristics) to console. */
+template <class G>
+void BidirectionalTester(int iterations, const G& graph, const Location& start, const Location& end, bool heuristics) {
+	cout << AlgorithmStrings[heuristics ? 8 : 7] << " Runtime: " << endl;
+	Graph reverse = Graph::transpose(graph);
+	ManhattanHeuristic toEnd(end);
+	ManhattanHeuristic toStart(start);
+	SearchContext forward(graph.size());
+	SearchContext backward(graph.size());
+	Path path;
+	printRuns(iterations, path, [&] {
+		if (heuristics) { BidirectionalSearch::search(graph, reverse, start, end, toEnd, toStart, forward, backward, path); }
+		else { BidirectionalSearch::search(graph, reverse, start, end, forward, backward, path); }
+	});
+}
+
+/** Prints runtimes and achieved bounds of a bounded-suboptimal A* to console. */
+template <class G>
+void BoundedTester(int iterations, Algorithm algorithm, const G& graph, const Location& start, const Location& end) {
+	cout << AlgorithmStrings[algorithm] << " Runtime (bound " << SUBOPTIMALITY_BOUND << "): " << endl;
+	ManhattanHeuristic heuristic(end);
+	SearchContext context(graph.size());
+	Path path;
+	printRuns(iterations, path, [&] {
+		BoundedSearch::search(graph, start, end, heuristic, SUBOPTIMALITY_BOUND, boundedMode(algorithm), context, path);
+	});
+}
+
+/** Prints runtimes of A* with the given heuristic to console. */
+template <class G>
+void AStarTester(int iterations, Algorithm algorithm, const G& graph, const Location& start, const Location& end, const Heuristic& heuristic) {
+	cout << AlgorithmStrings[algorithm] << " Runtime: " << endl;
+	SearchContext context(graph.size());
+	Path path;
+	printRuns(iterations, path, [&] { AStar::search(graph, start, end, heuristic, context, path); });
+}
+
 /** Prints runtimes of search algorithm to console. */
-void Tester(int iterations, Algorithm algorithm, const Graph& graph, const Location& start, const Location& end) {
+template <class G>
+void Tester(int iterations, Algorithm algorithm, const G& graph, const Location& start, const Location& end) {
 	switch (algorithm) {
 		case DIJKSTRA:
 			{
 				cout << AlgorithmStrings[0] << " Runtime: " << endl;
-				float average = 0;
-				float avgExplored = 0;
-				for (int i = 0; i < iterations; i++) {
-					Dijkstra search(graph, start, end);
-					auto start = steady_clock::now();
-					Path path = search.search();
-					auto end = steady_clock::now();
-					auto elapsed = duration_cast<chrono::seconds>(end - start).count();
-					cout << "\tIteration " << i << ": " << elapsed << " seconds" << endl;
-					cout << "\t             " << path.exploredNodes << " nodes explored" << endl << endl;
-					average += elapsed;
-					avgExplored += path.exploredNodes;
-				}
-				average /= iterations;
-				avgExplored /= avgExplored;
-				cout << "Average runtime over " << iterations << " iterations: " << average << " seconds" << endl;
-				cout << "Average memory over " << iterations << " iterations: " << (int)avgExplored << " nodes explored" << endl << endl;
+				SearchContext context(graph.size());
+				Path path;
+				printRuns(iterations, path, [&] { Dijkstra::search(graph, start, end, context, path); });
 				break;
 			}
 		case A_STAR_H1:
 			{
-				cout << AlgorithmStrings[1] << " Runtime: " << endl;
-				float average = 0;
-				float avgExplored = 0;
-				for (int i = 0; i < iterations; i++) {
-					AStar search(graph, start, end, ManhattanHeuristic(end));
-					auto start = steady_clock::now();
-					Path path = search.search();
-					auto end = steady_clock::now();
-					auto elapsed = duration_cast<chrono::seconds>(end - start).count();
-					cout << "\tIteration " << i << ": " << elapsed << " seconds" << endl;
-					cout << "\t             " << path.exploredNodes << " nodes explored" << endl << endl;
-					average += elapsed;
-					avgExplored += path.exploredNodes;
-				}
-				average /= iterations;
-				avgExplored /= avgExplored;
-				cout << "Average runtime over " << iterations << " iterations: " << average << " seconds" << endl;
-				cout << "Average memory over " << iterations << " iterations: " << (int)avgExplored << " nodes explored" << endl << endl;
-
+				AStarTester(iterations, algorithm, graph, start, end, ManhattanHeuristic(end));
 				break;
 			}
 		case A_STAR_H2:
 			{
-				cout << AlgorithmStrings[2] << " Runtime: " << endl;
-				float average = 0;
-				float avgExplored = 0;
-				for (int i = 0; i < iterations; i++) {
-					AStar search(graph, start, end, EuclideanHeuristic(end));
-					auto start = steady_clock::now();
-					Path path = search.search();
-					auto end = steady_clock::now();
-					auto elapsed = duration_cast<chrono::seconds>(end - start).count();
-					cout << "\tIteration " << i << ": " << elapsed << " seconds" << endl;
-					cout << "\t             " << path.exploredNodes << " nodes explored" << endl << endl;
-					average += elapsed;
-					avgExplored += path.exploredNodes;
-				}
-				average /= iterations;
-				avgExplored /= avgExplored;
-				cout << "Average runtime over " << iterations << " iterations: " << average << " seconds" << endl;
-				cout << "Average memory over " << iterations << " iterations: " << (int)avgExplored << " nodes explored" << endl << endl;
+				AStarTester(iterations, algorithm, graph, start, end, EuclideanHeuristic(end));
 				break;
 			}
-
 		case A_STAR_CUSTOM:
 			{
-				cout << AlgorithmStrings[3] << " Runtime: " << endl;
-				float average = 0;
-				float avgExplored = 0;
-				for (int i = 0; i < iterations; i++) {
-					AStar search(graph, start, end, CustomHeuristic(end));
-					auto start = steady_clock::now();
-					Path path = search.search();
-					auto end = steady_clock::now();
-					auto elapsed = duration_cast<chrono::seconds>(end - start).count();
-					cout << "\tIteration " << i << ": " << elapsed << " seconds" << endl;
-					cout << "\t             " << path.exploredNodes << " nodes explored" << endl << endl;
-					average += elapsed;
-					avgExplored += path.exploredNodes;
-				}
-				average /= iterations;
-				avgExplored /= avgExplored;
-				cout << "Average runtime over " << iterations << " iterations: " << average << " seconds" << endl;
-				cout << "Average memory over " << iterations << " iterations: " << (int)avgExplored << " nodes explored" << endl << endl;
+				AStarTester(iterations, algorithm, graph, start, end, CustomHeuristic(end));
+				break;
+			}
+		case A_STAR_LANDMARKS:
+			{
+				LandmarkTester(iterations, graph, start, end);
+				break;
+			}
+		case BIDIRECTIONAL_DIJKSTRA:
+			{
+				BidirectionalTester(iterations, graph, start, end, false);
+				break;
+			}
+		case BIDIRECTIONAL_A_STAR:
+			{
+				BidirectionalTester(iterations, graph, start, end, true);
+				break;
+			}
+		case A_STAR_WEIGHTED:
+		case A_STAR_OPTIMISTIC:
+		case A_STAR_FOCAL:
+			{
+				BoundedTester(iterations, algorithm, graph, start, end);
+				break;
+			}
+		case JUMP_POINT:
+		case HIERARCHICAL:
+			{
+				fail("grid graph algorithm choice on an explicit graph");
 				break;
 			}
 		case INVALID_ALG:
@@ -398,12 +627,594 @@ void Tester(int iterations, Algorithm algorithm, const Graph& graph, const Locat
 	}
 }
 
+/** Prints runtimes of search algorithm on grid graph to console, grid graph only algorithms included. */
+void GridTester(int iterations, Algorithm algorithm, const GridGraph& graph, const Location& start, const Location& end) {
+	if (algorithm == JUMP_POINT) { JumpPointTester(iterations, graph, start, end); }
+	else if (algorithm == HIERARCHICAL) { HierarchicalTester(iterations, graph, start, end); }
+	else { Tester(iterations, algorithm, graph, start, end); }
+}
+
+/** Prints the heap an A* search holds when copying the graph versus sharing its handle versus also reusing a context to console. */
+void MemoryTester(int iterations, const GraphHandle& graph, const Location& start, const Location& end) {
+	cout << "Heap per " << AlgorithmStrings[1] << " search: " << endl;
+	ManhattanHeuristic heuristic(end);
+	SearchContext context(graph->size());
+	Path path;
+	AStar::search(*graph, start, end, heuristic, context, path);
+	size_t searchBytes = context.getHeapBytes() + path.getHeapBytes();
+
+	// Each search holds its own copy of the graph (as searches used to), context and path.
+	Graph copy = *graph;
+	cout << "\tGraph copy:               " << copy.getHeapBytes() + searchBytes << " bytes" << endl;
+
+	// Each search shares the graph, but allocates its own context and path.
+	cout << "\tGraph handle:             " << searchBytes << " bytes" << endl;
+
+	// Searches share the graph and reuse one context and path, which only allocate if they grow.
+	for (int i = 0; i < iterations; i++) {
+		AStar::search(*graph, start, end, heuristic, context, path);
+	}
+	cout << "\tGraph handle and context: " << context.getHeapBytes() + path.getHeapBytes() - searchBytes << " bytes" << endl << endl;
+}
+
+/** Prints build time and heap of each graph representation of a maze to console. */
+void GraphTester(int rows, int cols) {
+	cout << "Graph build (" << rows << "x" << cols << " maze): " << endl;
+	Level level = generateMaze(rows, cols);
+
+	auto startTime = steady_clock::now();
+	Graph graph = levelToGraph(level);
+	auto endTime = steady_clock::now();
+	cout << "\tGraph:                 " << duration_cast<chrono::microseconds>(endTime - startTime).count() << " us, ";
+	cout << graph.getHeapBytes() << " bytes" << endl;
+
+	startTime = steady_clock::now();
+	GridGraph grid(level, false);
+	endTime = steady_clock::now();
+	cout << "\tGrid graph:            " << duration_cast<chrono::microseconds>(endTime - startTime).count() << " us, ";
+	cout << grid.getHeapBytes() << " bytes (views the level's " << level.cells.size() << ")" << endl;
+
+	startTime = steady_clock::now();
+	GridGraph jumps(level, false, true);
+	endTime = steady_clock::now();
+	cout << "\tGrid graph with jumps: " << duration_cast<chrono::microseconds>(endTime - startTime).count() << " us, ";
+	cout << jumps.getHeapBytes() << " bytes" << endl << endl;
+}
+
+/** Prints the average runtime of Dijkstra's search with the given open list to console. */
+template <class G>
+void QueueTester(const string& label, int iterations, const G& graph, const Location& start, const Location& end, DijkstraQueue queue) {
+	SearchContext context(graph.size());
+	Path path;
+	Dijkstra::search(graph, start, end, context, path, queue);
+	cout << "\t" << label << averageTime(iterations, [&](int) { Dijkstra::search(graph, start, end, context, path, queue); }) << " us, ";
+	cout << path.exploredNodes << " nodes explored" << endl;
+}
+
+/** Prints runtimes of Dijkstra's search with a heap versus a bucket queue between opposite corners of a level to console. */
+void DijkstraQueueTester(const string& name, int iterations, const Level& level, bool flag) {
+	GridGraph grid(level, flag);
+	GraphHandle graph = makeGraphHandle(levelToGraph(level, flag));
+	Location start(1, 1);
+	Location end = farCorner(grid, level.rows, level.cols);
+
+	cout << AlgorithmStrings[0] << " open list (" << name << ", max edge cost " << grid.getMaxIntegerCost() << "): " << endl;
+	QueueTester("Graph, heap:          ", iterations, *graph, start, end, HEAP_QUEUE);
+	QueueTester("Graph, buckets:       ", iterations, *graph, start, end, BUCKET_QUEUE);
+	QueueTester("Grid graph, heap:     ", iterations, grid, start, end, HEAP_QUEUE);
+	QueueTester("Grid graph, buckets:  ", iterations, grid, start, end, BUCKET_QUEUE);
+	cout << endl;
+}
+
+/** Prints the average runtime of A* instantiated for the heuristic's static type H to console. */
+template <class G, class H>
+void DispatchTester(const string& label, int iterations, const G& graph, const Location& start, const Location& end, const H& heuristic) {
+	SearchContext context(graph.size());
+	Path path;
+	AStar::search(graph, start, end, heuristic, context, path);
+	cout << "\t" << label << averageTime(iterations, [&](int) { AStar::search(graph, start, end, heuristic, context, path); }) << " us, ";
+	cout << path.exploredNodes << " nodes explored" << endl;
+}
+
+/** Prints runtimes of A* with heuristic H called virtually versus inlined on a graph and grid graph to console. */
+template <class H>
+void DispatchTester(const string& label, const string& name, int iterations, const Graph& graph, const GridGraph& grid,
+	const Location& start, const Location& end) {
+	H heuristic(end);
+	const Heuristic& base = heuristic;
+	cout << label << " dispatch (" << name << "): " << endl;
+	DispatchTester("Graph, virtual:       ", iterations, graph, start, end, base);
+	DispatchTester("Graph, static:        ", iterations, graph, start, end, heuristic);
+	DispatchTester("Grid graph, virtual:  ", iterations, grid, start, end, base);
+	DispatchTester("Grid graph, static:   ", iterations, grid, start, end, heuristic);
+}
+
+/** Prints runtimes of A* with each distance heuristic called virtually versus inlined between opposite corners of a level to console. */
+void HeuristicDispatchTester(const string& name, int iterations, const Level& level, bool flag) {
+	GridGraph grid(level, flag);
+	GraphHandle graph = makeGraphHandle(levelToGraph(level, flag));
+	Location start(1, 1);
+	Location end = farCorner(grid, level.rows, level.cols);
+	DispatchTester<ManhattanHeuristic>(AlgorithmStrings[1], name, iterations, *graph, grid, start, end);
+	DispatchTester<EuclideanHeuristic>(AlgorithmStrings[2], name, iterations, *graph, grid, start, end);
+	DispatchTester<CustomHeuristic>(AlgorithmStrings[3], name, iterations, *graph, grid, start, end);
+	cout << endl;
+}
+
+/** Prints explored nodes and runtime of A* versus jump point search between opposite corners of a level to console. */
+void JumpPointLevelTester(const string& name, int iterations, const Level& level, bool flag) {
+	GridGraph grid(level, flag, true);
+	Location start(1, 1);
+	Location end = farCorner(grid, level.rows, level.cols);
+	ManhattanHeuristic heuristic(end);
+	SearchContext context(grid.size());
+	Path path;
+
+	cout << AlgorithmStrings[1] << " versus " << AlgorithmStrings[4] << " (" << name << "): " << endl;
+	AStar::search(grid, start, end, heuristic, context, path);
+	cout << "\tA*:                   " << averageTime(iterations, [&](int) { AStar::search(grid, start, end, heuristic, context, path); }) << " us, ";
+	cout << path.exploredNodes << " nodes explored" << endl;
+
+	JumpPointSearch::search(grid, start, end, heuristic, context, path);
+	cout << "\tJump point search:    " << averageTime(iterations, [&](int) { JumpPointSearch::search(grid, start, end, heuristic, context, path); }) << " us, ";
+	cout << path.exploredNodes << " nodes explored" << endl << endl;
+}
+
+/** Returns the cost of the path in the grid graph. */
+float pathCost(const GridGraph& grid, const Path& path) {
+	float cost = 0;
+	for (int i = 1; i < path.size(); i++) { cost += grid.getCost(grid.index(path.getLocation(i))); }
+	return cost;
+}
+
+/** Prints explored nodes, runtime and path cost of A* versus hierarchical A* between opposite corners of a level to console. */
+void HierarchicalLevelTester(const string& name, int iterations, const Level& level, bool flag, int clusterSize) {
+	GridGraph grid(level, flag);
+	Location start(1, 1);
+	Location end = farCorner(grid, level.rows, level.cols);
+	ManhattanHeuristic heuristic(end);
+
+	auto startTime = steady_clock::now();
+	ClusterGraph clusters(grid, clusterSize);
+	auto endTime = steady_clock::now();
+	cout << AlgorithmStrings[1] << " versus " << AlgorithmStrings[5] << " (" << name << ", " << clusterSize << "x" << clusterSize << " clusters): " << endl;
+	cout << "\tAbstract graph:       " << duration_cast<chrono::milliseconds>(endTime - startTime).count() << " ms, ";
+	cout << clusters.size() << " nodes, " << clusters.getEdgeCount() << " edges" << endl;
+
+	SearchContext context(grid.size());
+	Path path;
+	AStar::search(grid, start, end, heuristic, context, path);
+	cout << "\tA*:                   " << averageTime(iterations, [&](int) { AStar::search(grid, start, end, heuristic, context, path); }) << " us, ";
+	cout << path.exploredNodes << " nodes explored, cost " << pathCost(grid, path) << endl;
+
+	HierarchicalContext hierarchicalContext(clusters);
+	HierarchicalPath plan;
+	cout << "\tHierarchical search:  " << averageTime(iterations, [&](int) { HierarchicalSearch::search(clusters, start, end, heuristic, hierarchicalContext, plan); }) << " us, ";
+	cout << plan.getPath().exploredNodes << " nodes explored (" << plan.getWaypoints().size() << " waypoints)" << endl;
+
+	startTime = steady_clock::now();
+	HierarchicalSearch::refine(clusters, hierarchicalContext, plan, 1);
+	endTime = steady_clock::now();
+	cout << "\tFirst segment:        " << duration_cast<chrono::microseconds>(endTime - startTime).count() << " us" << endl;
+	startTime = steady_clock::now();
+	HierarchicalSearch::refine(clusters, hierarchicalContext, plan, plan.getWaypoints().size());
+	endTime = steady_clock::now();
+	cout << "\tRest of refinement:   " << duration_cast<chrono::microseconds>(endTime - startTime).count() << " us, ";
+	cout << plan.getPath().exploredNodes << " nodes explored in total, cost " << pathCost(grid, plan.getPath()) << endl << endl;
+}
+
+/** Prints build time and memory of a maze's tree oracle and its query times versus A* to console. */
+void TreeOracleTester(int iterations, int rows, int cols) {
+	cout << "Tree oracle (" << rows << "x" << cols << " maze): " << endl;
+	Maze maze(rows, cols);
+	const GridGraph& grid = maze.getGridGraph();
+	Location start(1, 1);
+	Location end = farCorner(grid, rows, cols);
+
+	auto startTime = steady_clock::now();
+	const TreeOracle* oracle = maze.getTreeOracle();
+	auto endTime = steady_clock::now();
+	if (oracle == nullptr) {
+		cout << "\tMaze is not a tree" << endl << endl;
+		return;
+	}
+	cout << "\tBuild:                " << duration_cast<chrono::milliseconds>(endTime - startTime).count() << " ms, ";
+	cout << oracle->getHeapBytes() << " bytes" << endl;
+
+	ManhattanHeuristic heuristic(end);
+	SearchContext context(grid.size());
+	Path path;
+	AStar::search(grid, start, end, heuristic, context, path);
+	cout << "\tA* path:              " << averageTime(iterations, [&](int) { AStar::search(grid, start, end, heuristic, context, path); }) << " us, ";
+	cout << path.size() << " cells, " << path.exploredNodes << " nodes explored" << endl;
+
+	int length = 0;
+	cout << "\tOracle length:        " << averageTime<chrono::nanoseconds>(iterations, [&](int) { length = oracle->getLength(start, end); }) << " ns, ";
+	cout << length << " edges" << endl;
+
+	cout << "\tOracle path:          " << averageTime(iterations, [&](int) { oracle->getPath(start, end, path); }) << " us, ";
+	cout << path.size() << " cells" << endl << endl;
+}
+
+/** Prints explored nodes, runtime and path cost of A* with the manhattan versus the landmark heuristic across a level to console. */
+void LandmarkLevelTester(const string& name, int iterations, const Level& level, bool flag) {
+	GridGraph grid(level, flag);
+	Location start(1, 1);
+	Location end = farCorner(grid, level.rows, level.cols);
+
+	auto startTime = steady_clock::now();
+	Landmarks landmarks(grid, LANDMARKS);
+	auto endTime = steady_clock::now();
+	cout << AlgorithmStrings[1] << " versus " << AlgorithmStrings[6] << " (" << name << "): " << endl;
+	cout << "\tLandmarks:            " << duration_cast<chrono::milliseconds>(endTime - startTime).count() << " ms, ";
+	cout << landmarks.size() << " landmarks" << endl;
+
+	SearchContext context(grid.size());
+	Path path;
+	ManhattanHeuristic manhattan(end);
+	cout << "\tManhattan:            " << averageTime(iterations, [&](int) { AStar::search(grid, start, end, manhattan, context, path); }) << " us, ";
+	cout << path.exploredNodes << " nodes explored, cost " << pathCost(grid, path) << endl;
+
+	LandmarkHeuristic heuristic(landmarks, end);
+	cout << "\tLandmarks:            " << averageTime(iterations, [&](int) { AStar::search(grid, start, end, heuristic, context, path); }) << " us, ";
+	cout << path.exploredNodes << " nodes explored, cost " << pathCost(grid, path) << endl << endl;
+}
+
+/** Prints the throughput of a batch of A* queries on a maze answered by search pools of growing size to console. */
+void SearchPoolTester(int queryCount, int rows, int cols) {
+	cout << "Search pool (" << queryCount << " " << AlgorithmStrings[1] << " queries, " << rows << "x" << cols << " maze): " << endl;
+	Maze maze(rows, cols);
+	const Graph& graph = *maze.getGraph();
+
+	// Heuristics are owned here and only read by the workers.
+	vector<ManhattanHeuristic> heuristics;
+	vector<PathQuery> queries;
+	heuristics.reserve(queryCount);
+	for (const auto& query : randomQueries(graph, queryCount)) {
+		heuristics.push_back(ManhattanHeuristic(query.second));
+		queries.push_back(PathQuery(query.first, query.second, &heuristics.back()));
+	}
+
+	long long serial = 0;
+	int hardware = max(1u, thread::hardware_concurrency());
+	vector<int> threadCounts;
+	for (int threads = 1; threads < hardware; threads *= 2) { threadCounts.push_back(threads); }
+	threadCounts.push_back(hardware);
+	vector<PathResult> results;
+	for (int threads : threadCounts) {
+		SearchPool pool(maze.getGraph(), threads);
+		pool.run(queries, results);
+		auto startTime = steady_clock::now();
+		pool.run(queries, results);
+		auto endTime = steady_clock::now();
+		long long elapsed = max(1LL, (long long)duration_cast<chrono::microseconds>(endTime - startTime).count());
+		if (threads == 1) { serial = elapsed; }
+		long long searching = 0;
+		for (const auto& result : results) { searching += result.microseconds; }
+		cout << "\t" << threads << (threads == 1 ? " thread:  " : " threads: ") << elapsed / 1000 << " ms, ";
+		cout << queryCount * 1000000LL / elapsed << " queries/s, " << searching / queryCount << " us per query, ";
+		cout << (float)serial / elapsed << "x" << endl;
+	}
+	cout << endl;
+}
+
+/** Prints the runtime of agents re-planning to a few goals on a maze with and without a path cache, and its stats, to console. */
+void PathCacheTester(int queryCount, int goalCount, int rows, int cols) {
+	cout << "Path cache (" << queryCount << " " << AlgorithmStrings[1] << " queries to " << goalCount << " goals, " << rows << "x" << cols << " maze): " << endl;
+	Level level = generateMaze(rows, cols);
+	GraphHandle handle = makeGraphHandle(levelToGraph(level));
+	const Graph& graph = *handle;
+	vector<int> cells = openCells(graph);
+
+	// Agents start anywhere but head to a few goals, and repeat earlier queries.
+	vector<Location> goals;
+	for (int i = 0; i < goalCount; i++) { goals.push_back(randomCell(graph, cells)); }
+	vector<pair<Location, Location>> queries;
+	for (int i = 0; i < queryCount; i++) {
+		if (i > 0 && rand() % 2 == 0) { queries.push_back(queries[rand() % i]); }
+		else { queries.push_back(make_pair(randomCell(graph, cells), goals[rand() % goalCount])); }
+	}
+
+	SearchContext context(graph.size());
+	Path path;
+	int explored = 0;
+	long long elapsed = averageTime(queryCount, [&](int i) {
+		AStar::search(graph, queries[i].first, queries[i].second, ManhattanHeuristic(queries[i].second), context, path);
+		explored += path.exploredNodes;
+	});
+	cout << "	Uncached:             " << elapsed << " us per query, ";
+	cout << explored / queryCount << " nodes explored per query" << endl;
+
+	PathCache cache(handle, PATH_CACHE_CAPACITY);
+	explored = 0;
+	elapsed = averageTime(queryCount, [&](int i) {
+		cache.search(queries[i].first, queries[i].second, ManhattanHeuristic(queries[i].second), true, context, path);
+		explored += path.exploredNodes;
+	});
+	const PathCacheStats& stats = cache.getStats();
+	cout << "	Cached:               " << elapsed << " us per query, ";
+	cout << explored / queryCount << " nodes explored per query, hit rate " << stats.getHitRate() << " (";
+	cout << stats.hits << " hits, " << stats.suffixHits << " suffix hits, " << stats.misses << " misses, " << stats.evictions << " evictions)" << endl;
+
+	// Changing a cell rebuilds the graph, which drops every cached path.
+	level.cells.setCost(1, 1, pricey);
+	cache.setGraph(makeGraphHandle(levelToGraph(level)));
+	cache.search(queries[0].first, queries[0].second, ManhattanHeuristic(queries[0].second), true, context, path);
+	cout << "	After a level change: " << stats.invalidations << " invalidation, " << cache.size() << " cached path" << endl << endl;
+}
+
+/** Prints the per-frame cost of a monster replanning its chase of a wandering character with A* versus D* Lite to console. */
+void IncrementalTester(const string& name, int frames, const Level& level, bool flag) {
+	cout << AlgorithmStrings[1] << " versus D* Lite replanning every frame (" << name << ", " << frames << " frames): " << endl;
+	GraphHandle graph = makeGraphHandle(levelToGraph(level, flag));
+
+	// The monster steps along its path every other frame, the character to a random neighbor every fourth while it walks (a third of the time).
+	vector<pair<Location, Location>> chase;
+	pair<Location, Location> first = randomQueries(*graph, 1).front();
+	Location monster = first.first;
+	Location character = first.second;
+	SearchContext context(graph->size());
+	Path path;
+	for (int frame = 0; frame < frames; frame++) {
+		chase.push_back(make_pair(monster, character));
+		AStar::search(*graph, monster, character, ManhattanHeuristic(character), context, path);
+		if (frame % 2 == 0 && path.size() > 1) { monster = path.getLocation(1); }
+		auto edges = graph->getOutgoingEdges(graph->index(character));
+		if (frame % 4 == 0 && frame % 60 < 20 && !edges.isEmpty()) { character = graph->localize(edges.target(rand() % edges.size())); }
+	}
+
+	int explored = 0;
+	long long elapsed = averageTime(frames, [&](int frame) {
+		AStar::search(*graph, chase[frame].first, chase[frame].second, ManhattanHeuristic(chase[frame].second), context, path);
+		explored += path.exploredNodes;
+	});
+	cout << "\tA*:                   " << elapsed << " us, ";
+	cout << (double)explored / frames << " nodes explored per frame" << endl;
+
+	DStarLite planner(graph);
+	explored = 0;
+	elapsed = averageTime(frames, [&](int frame) {
+		planner.plan(chase[frame].first, chase[frame].second, path);
+		explored += path.exploredNodes;
+	});
+	cout << "\tD* Lite:              " << elapsed << " us, ";
+	cout << (double)explored / frames << " nodes expanded per frame" << endl << endl;
+}
+
+/** Prints the per-step cost of a flow field following a wandering goal, repaired versus recomputed, and of A* for each agent instead, to console. */
+void FlowFieldTester(const string& name, int steps, int agents, const Level& level, bool flag) {
+	cout << "Flow field (" << name << ", " << steps << " goal steps, " << agents << " agents): " << endl;
+	GraphHandle graph = makeGraphHandle(levelToGraph(level, flag));
+	vector<int> cells = openCells(*graph);
+
+	// The goal steps to a random neighbor every time.
+	vector<Location> goals;
+	goals.push_back(randomCell(*graph, cells));
+	for (int step = 1; step < steps; step++) {
+		auto edges = graph->getOutgoingEdges(graph->index(goals.back()));
+		goals.push_back(graph->localize(edges.target(rand() % edges.size())));
+	}
+	vector<Location> starts;
+	for (int i = 0; i < agents; i++) { starts.push_back(randomCell(*graph, cells)); }
+
+	FlowField field(graph);
+	int expanded = 0;
+	cout << "\tRepaired:             " << averageTime(steps, [&](int step) { expanded += field.setGoal(goals[step]); }) << " us, ";
+	cout << expanded / steps << " nodes expanded per step" << endl;
+
+	// Only the search of a fresh field is timed, not building it.
+	expanded = 0;
+	long long recomputing = 0;
+	for (const auto& goal : goals) {
+		FlowField fresh(graph);
+		recomputing += averageTime(1, [&](int) { expanded += fresh.setGoal(goal); });
+	}
+	cout << "\tRecomputed:           " << recomputing / steps << " us, ";
+	cout << expanded / steps << " nodes expanded per step" << endl;
+
+	SearchContext context(graph->size());
+	Path path;
+	int explored = 0;
+	int queries = min(steps, 100);
+	long long elapsed = averageTime(queries, [&](int step) {
+		for (const auto& start : starts) {
+			AStar::search(*graph, start, goals[step], ManhattanHeuristic(goals[step]), context, path);
+			explored += path.exploredNodes;
+		}
+	});
+	cout << "\tA* per agent:         " << elapsed << " us, ";
+	cout << explored / queries << " nodes explored per step" << endl << endl;
+}
+
+/** Prints the frame time of agents requesting paths on a maze at once, searched in one frame versus sliced by a scheduler, to console. */
+void SlicedSearchTester(int agents, int budget, int rows, int cols) {
+	cout << "Sliced " << AlgorithmStrings[1] << " (" << agents << " agents, " << budget << " expansions per frame, " << rows << "x" << cols << " maze): " << endl;
+	Maze maze(rows, cols);
+	const Graph& graph = *maze.getGraph();
+	vector<Location> starts;
+	vector<shared_ptr<const Heuristic>> heuristics;
+	for (const auto& query : randomQueries(graph, agents)) {
+		starts.push_back(query.first);
+		heuristics.push_back(make_shared<ManhattanHeuristic>(query.second));
+	}
+
+	// Every agent searches in the same frame.
+	SearchContext context(graph.size());
+	Path path;
+	auto startTime = steady_clock::now();
+	for (int i = 0; i < agents; i++) {
+		AStar::search(graph, starts[i], heuristics[i]->getGoalLocation(), *heuristics[i], context, path);
+	}
+	auto endTime = steady_clock::now();
+	cout << "\tOne frame:            " << duration_cast<chrono::microseconds>(endTime - startTime).count() << " us" << endl;
+
+	// The scheduler spreads the searches over frames.
+	vector<SlicedAStar> searches(agents, SlicedAStar(maze.getGraph()));
+	SearchScheduler scheduler(budget);
+	for (int i = 0; i < agents; i++) {
+		searches[i].begin(starts[i], heuristics[i]->getGoalLocation(), heuristics[i]);
+		scheduler.submit(searches[i]);
+	}
+	int frames = 0;
+	long long longest = 0;
+	long long total = 0;
+	while (scheduler.size() > 0) {
+		startTime = steady_clock::now();
+		scheduler.run();
+		endTime = steady_clock::now();
+		long long elapsed = duration_cast<chrono::microseconds>(endTime - startTime).count();
+		longest = max(longest, elapsed);
+		total += elapsed;
+		frames++;
+	}
+	cout << "\tSliced:               " << frames << " frames, " << longest << " us longest frame, " << total << " us total" << endl << endl;
+}
+
+/** Prints the main thread's time per path request on a maze when searching itself versus submitting to a path service, and the service's latency, to console. */
+void PathServiceTester(int requestCount, int rows, int cols) {
+	cout << "Path service (" << requestCount << " " << AlgorithmStrings[1] << " requests, " << rows << "x" << cols << " maze): " << endl;
+	Maze maze(rows, cols);
+	const Graph& graph = *maze.getGraph();
+	vector<Location> starts;
+	vector<shared_ptr<const Heuristic>> heuristics;
+	for (const auto& query : randomQueries(graph, requestCount)) {
+		starts.push_back(query.first);
+		heuristics.push_back(make_shared<ManhattanHeuristic>(query.second));
+	}
+
+	SearchContext context(graph.size());
+	Path path;
+	cout << "\tMain thread:          " << averageTime(requestCount, [&](int i) {
+		AStar::search(graph, starts[i], heuristics[i]->getGoalLocation(), *heuristics[i], context, path);
+	}) << " us per request" << endl;
+
+	// Every other request is cancelled right away, as by an agent changing its mind.
+	PathService service(maze.getGraph(), max(1u, thread::hardware_concurrency()));
+	vector<shared_ptr<PathTicket>> tickets;
+	auto startTime = steady_clock::now();
+	for (int i = 0; i < requestCount; i++) {
+		tickets.push_back(service.request(starts[i], heuristics[i]->getGoalLocation(), heuristics[i]));
+		if (i % 2 == 1) { tickets.back()->cancel(); }
+	}
+	auto endTime = steady_clock::now();
+	long long submitting = duration_cast<chrono::microseconds>(endTime - startTime).count();
+	int cancelled = 0;
+	for (const auto& ticket : tickets) {
+		while (ticket->isPending()) { this_thread::yield(); }
+		cancelled += ticket->getStatus() == PATH_CANCELLED;
+	}
+	endTime = steady_clock::now();
+	cout << "\tService:              " << (float)submitting / requestCount << " us per request on the main thread, ";
+	cout << duration_cast<chrono::milliseconds>(endTime - startTime).count() << " ms until all answered, " << cancelled << " cancelled unsearched, ";
+	cout << service.getThreadCount() << (service.getThreadCount() == 1 ? " worker" : " workers") << endl << endl;
+}
+
+/** Prints runtime, explored nodes, path cost and achieved bound of A* versus its bounded-suboptimal modes between opposite corners of a level to console. */
+void BoundedLevelTester(const string& name, int iterations, const Level& level, bool flag) {
+	GridGraph grid(level, flag);
+	Location start(1, 1);
+	Location end = farCorner(grid, level.rows, level.cols);
+	ManhattanHeuristic heuristic(end);
+	SearchContext context(grid.size());
+	Path path;
+
+	cout << AlgorithmStrings[1] << " versus bounded-suboptimal A* (" << name << "): " << endl;
+	long long elapsed = averageTime(iterations, [&](int) { AStar::search(grid, start, end, heuristic, context, path); });
+	float optimal = pathCost(grid, path);
+	cout << "\tA*:                   " << elapsed << " us, ";
+	cout << path.exploredNodes << " nodes explored, cost " << optimal << endl;
+
+	CustomHeuristic custom(end);
+	cout << "\tCustom heuristic:     " << averageTime(iterations, [&](int) { AStar::search(grid, start, end, custom, context, path); }) << " us, ";
+	cout << path.exploredNodes << " nodes explored, cost " << pathCost(grid, path) / optimal << "x optimal, no bound" << endl;
+
+	vector<pair<string, BoundedMode>> modes = {
+		{ "Weighted", WEIGHTED_SEARCH }, { "Optimistic", OPTIMISTIC_SEARCH }, { "Focal", FOCAL_SEARCH }
+	};
+	for (float weight : { 1.25f, 1.5f, 2.f, 3.f }) {
+		for (const auto& mode : modes) {
+			elapsed = averageTime(iterations, [&](int) { BoundedSearch::search(grid, start, end, heuristic, weight, mode.second, context, path); });
+			string label = mode.first + " " + to_string(weight).substr(0, 4) + ":";
+			cout << "\t" << label << string(22 - label.size(), ' ');
+			cout << elapsed << " us, ";
+			cout << path.exploredNodes << " nodes explored, cost " << pathCost(grid, path) / optimal << "x optimal, ";
+			cout << "bound " << path.bound << endl;
+		}
+	}
+	cout << endl;
+}
+
+/** Prints the size of a level's corridor graph and A* on it (plus expansion) versus A* on the full graph to console. */
+void CorridorTester(const string& name, int iterations, const Level& level, bool flag) {
+	cout << "Corridor contraction (" << name << "): " << endl;
+	GraphHandle handle = makeGraphHandle(levelToGraph(level, flag));
+	const Graph& graph = *handle;
+	Location start(1, 1);
+	Location end = farCorner(graph, level.rows, level.cols);
+
+	int vertices = openCells(graph).size();
+	auto startTime = steady_clock::now();
+	CorridorGraph corridors(handle);
+	auto endTime = steady_clock::now();
+	if (corridors.size() > vertices) { fail("corridor contraction added nodes"); }
+	cout << "\tContraction:          " << duration_cast<chrono::microseconds>(endTime - startTime).count() << " us, ";
+	cout << vertices << " vertices to " << corridors.size() << " nodes, " << corridors.getEdgeCount() << " edges" << endl;
+
+	ManhattanHeuristic heuristic(end);
+	SearchContext context(graph.size());
+	Path path;
+	AStar::search(graph, start, end, heuristic, context, path);
+	cout << "\tA*:                   " << averageTime(iterations, [&](int) { AStar::search(graph, start, end, heuristic, context, path); }) << " us, ";
+	cout << path.exploredNodes << " nodes explored, " << path.size() << " cells" << endl;
+
+	SearchContext corridorContext(corridors.size() + 2);
+	Path waypoints;
+	cout << "\tCorridor A*:          " << averageTime(iterations, [&](int) { CorridorSearch::search(corridors, start, end, heuristic, corridorContext, waypoints); }) << " us, ";
+	cout << waypoints.exploredNodes << " nodes explored, " << waypoints.size() << " waypoints" << endl;
+
+	cout << "\tExpansion:            " << averageTime(iterations, [&](int) { corridors.expand(waypoints, path); }) << " us, ";
+	cout << path.size() << " cells" << endl << endl;
+}
+
 /** Prints runtimes of all search algorithms on big graph to console. */
 void Test(int iterations) {
+	GraphTester(100, 100);
+	GraphTester(200, 200);
+	DijkstraQueueTester("character level", iterations, generateCharacterLevel(), true);
+	DijkstraQueueTester("200x200 maze", iterations, generateMaze(200, 200), false);
+	HeuristicDispatchTester("character level", iterations, generateCharacterLevel(), true);
+	HeuristicDispatchTester("200x200 maze", iterations, generateMaze(200, 200), false);
+	JumpPointLevelTester("character level", iterations, generateCharacterLevel(), true);
+	JumpPointLevelTester("100x100 open level", iterations, generateOpenLevel(100, 100), true);
+	JumpPointLevelTester("100x100 maze", iterations, generateMaze(100, 100), false);
+	HierarchicalLevelTester("character level", iterations, generateCharacterLevel(), true, 11);
+	HierarchicalLevelTester("200x200 open level", iterations, generateOpenLevel(200, 200), true, CLUSTER_SIZE);
+	HierarchicalLevelTester("200x200 maze", iterations, generateMaze(200, 200), false, CLUSTER_SIZE);
+	TreeOracleTester(iterations, 100, 100);
+	TreeOracleTester(iterations, 200, 200);
+	CorridorTester("character level", iterations, generateCharacterLevel(), true);
+	CorridorTester("100x100 maze", iterations, generateMaze(100, 100), false);
+	CorridorTester("200x200 maze", iterations, generateMaze(200, 200), false);
+	LandmarkLevelTester("character level", iterations, generateCharacterLevel(), true);
+	LandmarkLevelTester("100x100 maze", iterations, generateMaze(100, 100), false);
+	LandmarkLevelTester("200x200 maze", iterations, generateMaze(200, 200), false);
+	SearchPoolTester(1000, 200, 200);
+	PathCacheTester(2000, 8, 200, 200);
+	IncrementalTester("character level", 1000, generateCharacterLevel(), true);
+	IncrementalTester("200x200 maze", 1000, generateMaze(200, 200), false);
+	FlowFieldTester("200x200 maze", 1000, 50, generateMaze(200, 200), false);
+	FlowFieldTester("200x200 open level", 1000, 50, generateOpenLevel(200, 200), true);
+	SlicedSearchTester(20, 20000, 200, 200);
+	PathServiceTester(1000, 200, 200);
+	BoundedLevelTester("character level", iterations, generateCharacterLevel(), true);
+	BoundedLevelTester("200x200 open level", iterations, generateOpenLevel(200, 200), true);
+	BoundedLevelTester("200x200 maze", iterations, generateMaze(200, 200), false);
+
+	// The tests above draw random numbers, so the seed is reset for the baseline maze (its fixed cells are open in it).
+	srand(1);
 	MAZE_X = 100;
 	MAZE_Y = 100;
 	Maze maze(MAZE_X, MAZE_Y);
-	auto l = maze.getLevel();
 
 	vector<Location> starts;
 	starts.push_back(Location(1, 1));
@@ -418,15 +1229,26 @@ void Test(int iterations) {
 	ends.push_back(Location(81, 11));
 	ends.push_back(Location(1, 1));
 
-	auto algorithms = { Algorithm::DIJKSTRA, Algorithm::A_STAR_H1, Algorithm::A_STAR_H2, Algorithm::A_STAR_CUSTOM };
+	auto algorithms = { Algorithm::DIJKSTRA, Algorithm::A_STAR_H1, Algorithm::A_STAR_H2, Algorithm::A_STAR_CUSTOM, Algorithm::A_STAR_LANDMARKS,
+		Algorithm::BIDIRECTIONAL_DIJKSTRA, Algorithm::BIDIRECTIONAL_A_STAR, Algorithm::A_STAR_WEIGHTED, Algorithm::A_STAR_OPTIMISTIC,
+		Algorithm::A_STAR_FOCAL };
+	auto gridAlgorithms = { Algorithm::DIJKSTRA, Algorithm::A_STAR_H1, Algorithm::A_STAR_H2, Algorithm::A_STAR_CUSTOM, Algorithm::JUMP_POINT,
+		Algorithm::HIERARCHICAL, Algorithm::A_STAR_LANDMARKS, Algorithm::BIDIRECTIONAL_DIJKSTRA, Algorithm::BIDIRECTIONAL_A_STAR,
+		Algorithm::A_STAR_WEIGHTED, Algorithm::A_STAR_OPTIMISTIC, Algorithm::A_STAR_FOCAL };
 	for (int i = 0; i < starts.size(); i++) {
 		cout << "======================================================" << endl;
 		cout << "Locations " << i << endl;
 		cout << "Start: (" << starts[i].x << ", " << starts[i].y << ")" << endl;
 		cout << "End: (" << ends[i].x << ", " << ends[i].y << ")" << endl;
+		cout << "Graph:" << endl << endl;
 		for (auto algorithm : algorithms) {
-			Tester(iterations, algorithm, maze.getGraph(), starts[i], ends[i]);
+			Tester(iterations, algorithm, *maze.getGraph(), starts[i], ends[i]);
+		}
+		cout << "Grid graph:" << endl << endl;
+		for (auto algorithm : gridAlgorithms) {
+			GridTester(iterations, algorithm, maze.getGridGraph(), starts[i], ends[i]);
 		}
+		MemoryTester(iterations, maze.getGraph(), starts[i], ends[i]);
 		cout << "======================================================" << endl << endl;
 	}
 }
@@ -1,17 +1,29 @@
 #include <SFML/Graphics.hpp>
 #include "../level/level.h"
 #include "../graph/graph.h"
+#include "../graph/gridgraph.h"
+#include "../search/treeoracle.h"
 #include "maze.h"
 
-Maze::Maze(int rows, int cols) : maze(generateMaze(rows, cols)), graph(levelToGraph(maze)) {
+Maze::Maze(int rows, int cols) : maze(generateMaze(rows, cols)), grid(maze, false, true) {
     Maze::rows = rows;
     Maze::cols = cols;
 }
 
-Graph Maze::getGraph() const {
+const GridGraph& Maze::getGridGraph() const {
+    return grid;
+}
+const GraphHandle& Maze::getGraph() const {
+    call_once(graphBuilt, [this] { graph = makeGraphHandle(levelToGraph(maze)); });
     return graph;
 }
-Level Maze::getLevel() const {
+const TreeOracle* Maze::getTreeOracle() const {
+    call_once(oracleBuilt, [this] {
+        if (TreeOracle::isForest(grid)) { oracle = make_shared<const TreeOracle>(grid); }
+    });
+    return oracle.get();
+}
+const Level& Maze::getLevel() const {
     return maze;
 }
 int Maze::getRows() const { return rows; }
@@ -2,8 +2,11 @@
 #define MAZE_H
 
 #include <SFML/Graphics.hpp>
+#include <mutex>
 #include "../level/level.h"
 #include "../graph/graph.h"
+#include "../graph/gridgraph.h"
+#include "../search/treeoracle.h"
 #include "maze.h"
 
 using namespace sf;
@@ -23,20 +26,34 @@ class Maze
     /** The maze. */
     Level maze;
 
-    /** The graph representation of the maze .*/
-    Graph graph;
+    /** The implicit graph representation of the maze (a view of it, what searches on the maze run on). */
+    GridGraph grid;
+
+    /** The explicit graph representation of the maze (built on first use, shared with searches). */
+    mutable GraphHandle graph;
+
+    /** Path oracle of the maze if it is a tree (built on first use). */
+    mutable shared_ptr<const TreeOracle> oracle;
+
+    /** Flags building the graph and oracle exactly once, even if first used from several threads at once. */
+    mutable once_flag graphBuilt;
+    mutable once_flag oracleBuilt;
 
     /** Default constructor for the maze. */
     Maze(int rows, int cols);
 
+    /** Not copyable, since the grid graph views this maze's level. */
+    Maze(const Maze& maze) = delete;
+    Maze& operator=(const Maze& maze) = delete;
+
     /** Maps vertex in graph to location in maze (level). */
     inline Location localize(const graph::Vertex& vertex) {
-        return graph.localize(vertex);
+        return grid.localize(vertex);
     }
 
     /** Maps location in maze (level) to GraphNode in graph. */
     inline GraphNode quantize(const Location& location) {
-        return graph.quantize(location);
+        return grid.quantize(location);
     }
 
     /** Draws the graph on the window. */
@@ -51,8 +68,10 @@ class Maze
     }
 
     /** Getters. */
-    Graph getGraph() const;
-    Level getLevel() const;
+    const GridGraph& getGridGraph() const;
+    const GraphHandle& getGraph() const;
+    const TreeOracle* getTreeOracle() const;
+    const Level& getLevel() const;
     int getRows() const;
     int getCols() const;
 };
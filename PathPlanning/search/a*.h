@@ -1,7 +1,42 @@
 #ifndef A_STAR
 #define A_STAR
 
+#include <chrono>
+#include <climits>
+#include "priorityqueue.h"
+#include "searchstate.h"
 #include "search.h"
+#include "searchcontext.h"
+
+/** How a run of the A* kernel (AStar::expand) ended. */
+enum ExpansionResult
+{
+    END_REACHED,        // The end was taken off the open list (and is left open).
+    OPEN_EXHAUSTED,     // The open list has nothing more to expand.
+    BUDGET_SPENT        // The expansion or time budget ran out first; expanding again resumes.
+};
+
+/**
+ * Open list policy of plain and weighted A*: the open vertex of smallest g + weight * h is
+ * expanded next. Policies tell the kernel which vertex to expand next (pop, -1 to stop) and
+ * are told of every vertex opened (push) and every open vertex reached cheaper (decrease, while
+ * its state still holds its old values).
+ */
+class BestFirstOpenList
+{
+    private:
+    IndexedPriorityQueue& queue;
+    float weight;
+
+    public:
+
+    /** Constructs the policy on queue (empty, or holding the search it resumes). */
+    inline BestFirstOpenList(IndexedPriorityQueue& queue, float weight = 1) : queue(queue), weight(weight) {}
+
+    inline int pop() { return queue.isEmpty() ? -1 : queue.pop(); }
+    inline void push(int vertex, float costSoFar, float heuristic) { queue.push(vertex, costSoFar + weight * heuristic); }
+    inline void decrease(int vertex, float costSoFar, float heuristic) { queue.decreaseKey(vertex, costSoFar + weight * heuristic); }
+};
 
 class AStar : public Search
 {
@@ -11,11 +46,135 @@ class AStar : public Search
 
     public:
     /** Default constructor. */
-    AStar(const Graph& graph, const Location& start, const Location& end, const Heuristic& heuristic);
+    AStar(const GraphHandle& graph, const Location& start, const Location& end, const Heuristic& heuristic);
 
     /** Returns path from start location to end location in graph. */
     Path search() const;
 
+    /**
+     * Finds the path from start to end in graph into path, reusing context and path storage.
+     * The context must have been constructed for graph's size. Does not copy the graph. The
+     * heuristic's static type picks the instantiation: a distance heuristic passed as itself (the
+     * final ManhattanHeuristic, say) has its compute() inlined into the loop, while one passed as
+     * a Heuristic is called virtually.
+     */
+    template <class G, class H>
+    static void search(const G& graph, const Location& start, const Location& end, const H& heuristic,
+        SearchContext& context, Path& path);
+
+    /** Opens the start vertex of a search in state and openList (an open list policy, as BestFirstOpenList). */
+    template <class H, class O>
+    static void open(const Location& start, int startVertex, const H& heuristic, SearchState& state, O& openList);
+
+    /**
+     * The A* kernel: expands the vertices openList picks until it picks endVertex or none, or
+     * budget (expansions, decremented per vertex taken) runs out or maxMicroseconds (if positive)
+     * pass. Every vertex keeps g + h as its estimated total cost, whatever openList orders by,
+     * and closed vertices reached cheaper are reopened. ClosedCount counts the closed vertices.
+     */
+    template <class G, class H, class O>
+    static ExpansionResult expand(const G& graph, const H& heuristic, int endVertex, SearchState& state, O& openList,
+        int& closedCount, int& budget, long long maxMicroseconds = 0);
+
 };
 
+template <class G, class H>
+inline void AStar::search(const G& graph, const Location& start, const Location& end, const H& heuristic,
+    SearchContext& context, Path& path) {
+    path.clear();
+
+    // Locations outside of the graph have no path.
+    if (!graph.contains(start) || !graph.contains(end)) { return; }
+    context.reset();
+    int startVertex = graph.index(start);
+    int endVertex = graph.index(end);
+    SearchState& state = context.getState();
+    BestFirstOpenList openList(context.getOpenList());
+    open(start, startVertex, heuristic, state, openList);
+    int closedCount = 0;
+    int budget = INT_MAX;
+    if (expand(graph, heuristic, endVertex, state, openList, closedCount, budget) == END_REACHED) {
+        state.toPath(graph, startVertex, endVertex, closedCount, path);
+    }
+}
+
+template <class H, class O>
+inline void AStar::open(const Location& start, int startVertex, const H& heuristic, SearchState& state, O& openList) {
+    float startHeuristic = heuristic.compute(start);
+    state.setCostSoFar(startVertex, 0);
+    state.setEstimatedTotalCost(startVertex, startHeuristic);
+    state.setState(startVertex, GraphNodeRecordState::open);
+    openList.push(startVertex, 0, startHeuristic);
+}
+
+template <class G, class H, class O>
+inline ExpansionResult AStar::expand(const G& graph, const H& heuristic, int endVertex, SearchState& state, O& openList,
+    int& closedCount, int& budget, long long maxMicroseconds) {
+    auto startTime = chrono::steady_clock::now();
+
+    // Run through the open list till it stops or the budget is spent (the clock is read every 16 expansions).
+    for (int count = 0; budget > 0; count++) {
+        if (maxMicroseconds > 0 && count > 0 && count % 16 == 0 &&
+            chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime).count() >= maxMicroseconds) {
+            return BUDGET_SPENT;
+        }
+
+        // Find the element the open list picks.
+        int current = openList.pop();
+        if (current == -1) { return OPEN_EXHAUSTED; }
+        budget--;
+
+        // Found the end.
+        if (current == endVertex) { return END_REACHED; }
+
+        // Otherwise get its outgoing edges.
+        auto edges = graph.getOutgoingEdges(current);
+        float currentCSF = state.getCostSoFar(current);
+
+        // Find best edge to traverse.
+        for (int i = 0; i < edges.size(); i++) {
+
+            // Get end node and it's cost so far (CSF).
+            int endNode = edges.target(i);
+            float endNodeCSF = currentCSF + edges.cost(i);
+            GraphNodeRecordState endNodeState = state.getState(endNode);
+
+            // Otherwise know node is unvisited, thus make new record.
+            if (endNodeState == GraphNodeRecordState::unvisited) {
+                float endNodeHeuristic = heuristic.compute(graph.localize(endNode));
+                state.setCostSoFar(endNode, endNodeCSF);
+                state.setEstimatedTotalCost(endNode, endNodeCSF + endNodeHeuristic);
+                state.setParent(endNode, current);
+                state.setState(endNode, GraphNodeRecordState::open);
+                openList.push(endNode, endNodeCSF, endNodeHeuristic);
+                continue;
+            }
+
+            // If shorter route not found, skip.
+            if (state.getCostSoFar(endNode) <= endNodeCSF) { continue; }
+
+            // Use compute heurisitic for end node (via old values).
+            float endNodeHeuristic = state.getEstimatedTotalCost(endNode) - state.getCostSoFar(endNode);
+
+            // If shorter route found to a closed node, reopen it.
+            if (endNodeState == GraphNodeRecordState::closed) {
+                state.setState(endNode, GraphNodeRecordState::open);
+                openList.push(endNode, endNodeCSF, endNodeHeuristic);
+                closedCount--;
+            }
+            else {
+                openList.decrease(endNode, endNodeCSF, endNodeHeuristic);
+            }
+            state.setCostSoFar(endNode, endNodeCSF);
+            state.setEstimatedTotalCost(endNode, endNodeCSF + endNodeHeuristic);
+            state.setParent(endNode, current);
+        }
+
+        // Finished viewing edges for current.
+        state.setState(current, GraphNodeRecordState::closed);
+        closedCount++;
+    }
+    return BUDGET_SPENT;
+}
+
 #endif
\ No newline at end of file
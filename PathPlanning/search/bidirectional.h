@@ -0,0 +1,75 @@
+#ifndef BIDIRECTIONAL_H
+#define BIDIRECTIONAL_H
+
+#include "../graph/graph.h"
+#include "search.h"
+#include "searchcontext.h"
+
+/**
+ * Bidirectional Dijkstra and A*. A forward search from the start and a backward search from
+ * the end (over the reversed graph, since edges are directed) take turns expanding whichever
+ * frontier is smaller, and every edge reaching a vertex the other side has seen may complete
+ * a shorter path. The search stops once the two smallest keys sum to at least the best path
+ * found, when no shorter path can remain.
+ *
+ * Bidirectional A* uses the average of the heuristics to the end and to the start as its
+ * potential, (h_end - h_start) / 2 forward and its negation backward, which keeps both sides
+ * consistent so the same stopping rule holds (both heuristics must be consistent).
+ */
+class BidirectionalSearch : public Search
+{
+    private:
+
+    /** Heuristics towards the end and towards the start (null for bidirectional Dijkstra). */
+    const Heuristic* toEnd;
+    const Heuristic* toStart;
+
+    /** Returns the forward potential of the vertex (0 without heuristics). */
+    template <class H>
+    static inline float potential(const H& graph, int vertex, const Heuristic* toEnd, const Heuristic* toStart) {
+        if (toEnd == nullptr) { return 0; }
+        Location location = graph.localize(vertex);
+        return (toEnd->compute(location) - toStart->compute(location)) / 2;
+    }
+
+    /**
+     * Expands the smallest vertex of one side (sign 1 forward, -1 backward, for its potential),
+     * updating the best path cost and its meeting vertex from the other side's costs.
+     */
+    template <class H>
+    static void expand(const H& graph, SearchState& state, IndexedPriorityQueue& openList, const SearchState& other,
+        const Heuristic* toEnd, const Heuristic* toStart, float sign, float& best, int& meet);
+
+    /** Runs the search with or without heuristics. */
+    template <class G>
+    static void run(const G& graph, const Graph& reverse, const Location& start, const Location& end, const Heuristic* toEnd,
+        const Heuristic* toStart, SearchContext& forward, SearchContext& backward, Path& path);
+
+    public:
+
+    /** Constructs a bidirectional Dijkstra search. */
+    BidirectionalSearch(const GraphHandle& graph, const Location& start, const Location& end);
+
+    /** Constructs a bidirectional A* search (the heuristics must outlive it). */
+    BidirectionalSearch(const GraphHandle& graph, const Location& start, const Location& end, const Heuristic& toEnd,
+        const Heuristic& toStart);
+
+    /** Returns path from start location to end location in graph (reversing the graph first). */
+    Path search() const;
+
+    /**
+     * Finds the path from start to end in graph into path with bidirectional Dijkstra, reusing
+     * the contexts and path storage. Reverse must be graph's transpose and both contexts must
+     * have been constructed for graph's size. Defined for Graph and GridGraph.
+     */
+    template <class G>
+    static void search(const G& graph, const Graph& reverse, const Location& start, const Location& end, SearchContext& forward,
+        SearchContext& backward, Path& path);
+
+    /** As above, with bidirectional A* guided by heuristics towards the end and towards the start. */
+    template <class G>
+    static void search(const G& graph, const Graph& reverse, const Location& start, const Location& end, const Heuristic& toEnd,
+        const Heuristic& toStart, SearchContext& forward, SearchContext& backward, Path& path);
+};
+
+#endif
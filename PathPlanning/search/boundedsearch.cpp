@@ -0,0 +1,236 @@
+#include <set>
+#include <limits>
+#include <climits>
+#include <utility>
+#include <algorithm>
+#include "../graph/graph.h"
+#include "../graph/gridgraph.h"
+#include "priorityqueue.h"
+#include "searchstate.h"
+#include "searchcontext.h"
+#include "search.h"
+#include "a*.h"
+#include "boundedsearch.h"
+
+using namespace std;
+
+/** Returns the bound cost over lowerBound proves, at least 1 and at most weight (which always holds). */
+static inline float achievedBound(float cost, float lowerBound, float weight) {
+    return lowerBound > 0 ? max(1.f, min(weight, cost / lowerBound)) : 1;
+}
+
+/**
+ * Open list policy of optimistic search (see AStar::expand). Both queues hold every open vertex,
+ * the open list keyed by g + (2w - 1) * h and the cleanup list by g + h; vertices expanded from
+ * one are dropped from the other when they reach its top. Stops once a path was found and the
+ * smallest g + h proves it within the bound.
+ */
+class OptimisticOpenList
+{
+    private:
+    const SearchState& state;
+    IndexedPriorityQueue& openList;
+    IndexedPriorityQueue& cleanupList;
+    int endVertex;
+    float weight;
+    float searchWeight;
+
+    /** Queues the vertex with the key, lowering its key if it is queued already. */
+    static inline void enqueue(IndexedPriorityQueue& queue, int vertex, float key) {
+        if (queue.contains(vertex)) { queue.decreaseKey(vertex, key); }
+        else { queue.push(vertex, key); }
+    }
+
+    public:
+
+    /** Whether the end was reached, and the lower bound on the optimal cost when the search stopped. */
+    bool found;
+    float lowerBound;
+
+    inline OptimisticOpenList(const SearchState& state, IndexedPriorityQueue& openList, IndexedPriorityQueue& cleanupList,
+        int endVertex, float weight) :
+        state(state), openList(openList), cleanupList(cleanupList), endVertex(endVertex), weight(weight),
+        searchWeight(2 * weight - 1), found(false), lowerBound(0) {}
+
+    inline int pop() {
+
+        // Vertices expanded from the other list are no longer open; drop them when they reach the top.
+        while (!openList.isEmpty() && state.getState(openList.top()) != GraphNodeRecordState::open) { openList.pop(); }
+        while (!cleanupList.isEmpty() && state.getState(cleanupList.top()) != GraphNodeRecordState::open) { cleanupList.pop(); }
+
+        // The optimal cost is at least the smallest open g + h, or the end's cost if it is on an optimal path.
+        float cost = found ? state.getCostSoFar(endVertex) : numeric_limits<float>::infinity();
+        lowerBound = cleanupList.isEmpty() ? cost : min(cost, cleanupList.topKey());
+
+        // Done once the bound proves the best path found, or nothing is left open.
+        if (cleanupList.isEmpty() || (found && weight * lowerBound >= cost)) { return -1; }
+
+        // Expand by g + (2w - 1) * h while it could still find a cheaper path, otherwise raise the lower bound.
+        if (!found || (!openList.isEmpty() && openList.topKey() < cost)) { return openList.pop(); }
+        return cleanupList.pop();
+    }
+
+    inline void push(int vertex, float costSoFar, float heuristic) {
+        enqueue(openList, vertex, costSoFar + searchWeight * heuristic);
+        enqueue(cleanupList, vertex, costSoFar + heuristic);
+    }
+
+    inline void decrease(int vertex, float costSoFar, float heuristic) { push(vertex, costSoFar, heuristic); }
+};
+
+/**
+ * Open list policy of A*ε (see AStar::expand). Open vertices are ordered by g + h, and those
+ * within weight of the smallest are also in the focal list keyed by h, which the next vertex
+ * is taken from.
+ */
+class FocalOpenList
+{
+    private:
+    const SearchState& state;
+    IndexedPriorityQueue& focalList;
+    float weight;
+
+    /** Open vertices ordered by g + h (ETC), so the ones that come within the bound can be walked. */
+    set<pair<float, int>> openSet;
+
+    /** Smallest ETC when the focal list was last filled, and weight times the current one. */
+    float smallest;
+    float threshold;
+
+    public:
+
+    /** Smallest ETC when the last vertex was taken, a lower bound on the optimal cost. */
+    float lowerBound;
+
+    inline FocalOpenList(const SearchState& state, IndexedPriorityQueue& focalList, float weight) :
+        state(state), focalList(focalList), weight(weight), smallest(numeric_limits<float>::infinity()),
+        threshold(numeric_limits<float>::infinity()), lowerBound(0) {}
+
+    inline int pop() {
+        if (openSet.empty()) { return -1; }
+
+        // As the smallest ETC rises, open vertices within weight of it join the focal list.
+        lowerBound = openSet.begin()->first;
+        threshold = weight * lowerBound;
+        if (lowerBound > smallest) {
+            auto last = openSet.upper_bound(make_pair(threshold, numeric_limits<int>::max()));
+            for (auto it = openSet.upper_bound(make_pair(weight * smallest, numeric_limits<int>::max())); it != last; ++it) {
+                if (!focalList.contains(it->second)) { focalList.push(it->second, it->first - state.getCostSoFar(it->second)); }
+            }
+        }
+        smallest = lowerBound;
+
+        // Take the focal vertex closest to the end, dropping any left out of the bound by a smaller ETC.
+        int current = -1;
+        while (!focalList.isEmpty() && current == -1) {
+            int vertex = focalList.pop();
+            if (state.getEstimatedTotalCost(vertex) <= threshold) { current = vertex; }
+        }
+        if (current == -1) { current = openSet.begin()->second; }
+        openSet.erase(make_pair(state.getEstimatedTotalCost(current), current));
+        return current;
+    }
+
+    /** Opens the vertex, in the focal list too if it is within the bound. */
+    inline void push(int vertex, float costSoFar, float heuristic) {
+        float estimatedTotalCost = costSoFar + heuristic;
+        openSet.insert(make_pair(estimatedTotalCost, vertex));
+        if (estimatedTotalCost <= threshold && !focalList.contains(vertex)) { focalList.push(vertex, heuristic); }
+    }
+
+    inline void decrease(int vertex, float costSoFar, float heuristic) {
+        openSet.erase(make_pair(state.getEstimatedTotalCost(vertex), vertex));
+        push(vertex, costSoFar, heuristic);
+    }
+};
+
+WeightedHeuristic::WeightedHeuristic(const Location& goal, float weight) : Heuristic(goal), weight(weight) {}
+
+BoundedSearch::BoundedSearch(const GraphHandle& graph, const Location& start, const Location& end, const Heuristic& heuristic,
+    float weight, BoundedMode mode) : Search(graph, start, end), heuristic(&heuristic), weight(weight), mode(mode) {}
+
+Path BoundedSearch::search() const {
+    SearchContext context(getGraph().size());
+    Path path;
+    search(getGraph(), getStart(), getEnd(), *heuristic, weight, mode, context, path);
+    return path;
+}
+
+template <class G>
+void BoundedSearch::search(const G& graph, const Location& start, const Location& end, const Heuristic& heuristic, float weight,
+    BoundedMode mode, SearchContext& context, Path& path) {
+    path.clear();
+
+    // Locations outside of the graph have no path.
+    if (!graph.contains(start) || !graph.contains(end)) { return; }
+    context.reset();
+    int startVertex = graph.index(start);
+    int endVertex = graph.index(end);
+    weight = max(weight, 1.f);
+
+    if (mode == FOCAL_SEARCH) {
+        runFocal(graph, start, startVertex, endVertex, heuristic, weight, context.getState(), context.getFocalList(), path);
+    }
+    else if (mode == OPTIMISTIC_SEARCH) {
+        runOptimistic(graph, start, startVertex, endVertex, heuristic, weight, context.getState(), context.getOpenList(),
+            context.getFocalList(), path);
+    }
+    else {
+        runWeighted(graph, start, startVertex, endVertex, heuristic, weight, context.getState(), context.getOpenList(), path);
+    }
+}
+
+template <class G>
+void BoundedSearch::runWeighted(const G& graph, const Location& start, int startVertex, int endVertex, const Heuristic& heuristic,
+    float weight, SearchState& state, IndexedPriorityQueue& openList, Path& path) {
+    BestFirstOpenList weighted(openList, weight);
+    AStar::open(start, startVertex, heuristic, state, weighted);
+    int closedCount = 0;
+    int budget = INT_MAX;
+    if (AStar::expand(graph, heuristic, endVertex, state, weighted, closedCount, budget) != END_REACHED) { return; }
+
+    // Found the end, the optimal cost is at least the smallest ETC left open (or the path's cost).
+    float cost = state.getCostSoFar(endVertex);
+    float lowerBound = cost;
+    for (int i = 0; i < openList.size(); i++) { lowerBound = min(lowerBound, state.getEstimatedTotalCost(openList.getVertex(i))); }
+    state.toPath(graph, startVertex, endVertex, closedCount, path);
+    path.bound = achievedBound(cost, lowerBound, weight);
+}
+
+template <class G>
+void BoundedSearch::runOptimistic(const G& graph, const Location& start, int startVertex, int endVertex, const Heuristic& heuristic,
+    float weight, SearchState& state, IndexedPriorityQueue& openList, IndexedPriorityQueue& cleanupList, Path& path) {
+    OptimisticOpenList optimistic(state, openList, cleanupList, endVertex, weight);
+    AStar::open(start, startVertex, heuristic, state, optimistic);
+    int closedCount = 0;
+    int budget = INT_MAX;
+
+    // Reaching the end gives a path, but not necessarily one within the bound yet.
+    while (AStar::expand(graph, heuristic, endVertex, state, optimistic, closedCount, budget) == END_REACHED) {
+        state.setState(endVertex, GraphNodeRecordState::closed);
+        closedCount++;
+        optimistic.found = true;
+    }
+    if (!optimistic.found) { return; }
+    state.toPath(graph, startVertex, endVertex, closedCount, path);
+    path.bound = achievedBound(state.getCostSoFar(endVertex), optimistic.lowerBound, weight);
+}
+
+template <class G>
+void BoundedSearch::runFocal(const G& graph, const Location& start, int startVertex, int endVertex, const Heuristic& heuristic,
+    float weight, SearchState& state, IndexedPriorityQueue& focalList, Path& path) {
+    FocalOpenList focal(state, focalList, weight);
+    AStar::open(start, startVertex, heuristic, state, focal);
+    int closedCount = 0;
+    int budget = INT_MAX;
+    if (AStar::expand(graph, heuristic, endVertex, state, focal, closedCount, budget) != END_REACHED) { return; }
+
+    // Found the end, within weight of the smallest ETC (a lower bound on the optimal cost).
+    state.toPath(graph, startVertex, endVertex, closedCount, path);
+    path.bound = achievedBound(state.getCostSoFar(endVertex), focal.lowerBound, weight);
+}
+
+template void BoundedSearch::search<Graph>(const Graph&, const Location&, const Location&, const Heuristic&, float, BoundedMode,
+    SearchContext&, Path&);
+template void BoundedSearch::search<GridGraph>(const GridGraph&, const Location&, const Location&, const Heuristic&, float,
+    BoundedMode, SearchContext&, Path&);
@@ -0,0 +1,89 @@
+#ifndef BOUNDED_SEARCH_H
+#define BOUNDED_SEARCH_H
+
+#include "../graph/graph.h"
+#include "search.h"
+#include "searchcontext.h"
+
+/** Ways a bounded-suboptimal search trades path cost for fewer expansions. */
+enum BoundedMode
+{
+    WEIGHTED_SEARCH,    // Weighted A*: expands by g + w * h.
+    OPTIMISTIC_SEARCH,  // Weighted A* with 2w - 1 for a first path, then expands by g + h until it is proven.
+    FOCAL_SEARCH        // A*ε: of the nodes with g + h within w of the smallest, expands the one closest to the end.
+};
+
+/**
+ * Weight times the manhattan distance. A* with it is weighted A* (A* reopens nodes), so on
+ * graphs whose edges cost at least 1 its paths cost at most weight times the optimal cost.
+ */
+class WeightedHeuristic final : public Heuristic
+{
+    private:
+    float weight;
+
+    public:
+
+    /** Default constructor. */
+    WeightedHeuristic(const Location& goal, float weight);
+
+    /** Returns heuristic value of location to goal location. */
+    inline float compute(const Location& location) const {
+        return weight * float(abs(getGoalLocation().x - location.x) + abs(getGoalLocation().y - location.y));
+    }
+};
+
+/**
+ * Bounded-suboptimal A*: given an admissible heuristic, every path found costs at most weight
+ * times the optimal path's cost, and the search stops as soon as it can prove that.
+ *
+ * Every search keeps the smallest g + h of its open nodes at hand, which is a lower bound on
+ * the optimal cost (some open node lies on an optimal path with its optimal g, as nodes are
+ * reopened when reached cheaper). The path's cost over that lower bound is the bound the
+ * search achieved, reported in Path::bound, and is often well under the weight.
+ */
+class BoundedSearch : public Search
+{
+    private:
+    const Heuristic* heuristic;
+    float weight;
+    BoundedMode mode;
+
+    /**
+     * The searches, each the A* kernel with its own open list policy. Weighted A*: the open list is
+     * keyed by g + w * h, and scanned for the smallest g + h at the end.
+     */
+    template <class G>
+    static void runWeighted(const G& graph, const Location& start, int startVertex, int endVertex, const Heuristic& heuristic,
+        float weight, SearchState& state, IndexedPriorityQueue& openList, Path& path);
+
+    /** Optimistic search: the open list is keyed by g + (2w - 1) * h and the cleanup list by g + h. */
+    template <class G>
+    static void runOptimistic(const G& graph, const Location& start, int startVertex, int endVertex, const Heuristic& heuristic,
+        float weight, SearchState& state, IndexedPriorityQueue& openList, IndexedPriorityQueue& cleanupList, Path& path);
+
+    /** A*ε: vertices within weight of the smallest g + h are taken from the focal list keyed by h. */
+    template <class G>
+    static void runFocal(const G& graph, const Location& start, int startVertex, int endVertex, const Heuristic& heuristic,
+        float weight, SearchState& state, IndexedPriorityQueue& focalList, Path& path);
+
+    public:
+
+    /** Default constructor (the heuristic must outlive the search and be admissible). */
+    BoundedSearch(const GraphHandle& graph, const Location& start, const Location& end, const Heuristic& heuristic,
+        float weight, BoundedMode mode);
+
+    /** Returns path from start location to end location in graph. */
+    Path search() const;
+
+    /**
+     * Finds a path from start to end in graph costing at most weight (at least 1) times the
+     * optimal cost into path, reusing context and path storage. The context must have been
+     * constructed for graph's size. Defined for Graph and GridGraph.
+     */
+    template <class G>
+    static void search(const G& graph, const Location& start, const Location& end, const Heuristic& heuristic, float weight,
+        BoundedMode mode, SearchContext& context, Path& path);
+};
+
+#endif
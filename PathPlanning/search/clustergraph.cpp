@@ -0,0 +1,181 @@
+#include <vector>
+#include "../graph/graph.h"
+#include "../graph/gridgraph.h"
+#include "priorityqueue.h"
+#include "searchstate.h"
+#include "searchcontext.h"
+#include "clustergraph.h"
+
+using namespace std;
+
+/** Row and column offsets of each direction (in Level::NEIGHBORS order). */
+static const int DIRECTIONS[4][2] = { {1, 0}, {0, 1}, {0, -1}, {-1, 0} };
+
+ClusterGraph::ClusterGraph(const GridGraph& grid, int clusterSize) : grid(&grid), clusterSize(clusterSize),
+    clusterRows((grid.getRows() + clusterSize - 1) / clusterSize), clusterCols((grid.getCols() + clusterSize - 1) / clusterSize),
+    nodes(grid.size(), -1) {
+    int rows = grid.getRows();
+    int cols = grid.getCols();
+
+    // Find transitions along the borders between horizontally, then vertically neighboring clusters.
+    vector<bool> transitions(grid.size(), false);
+    vector<int> links;
+    vector<float> linkCosts;
+    for (int col = clusterSize - 1; col + 1 < cols; col += clusterSize) {
+        for (int row = 0; row < rows; row += clusterSize) {
+            addEntrances(row * cols + col, cols, min(clusterSize, rows - row), 1, transitions, links, linkCosts);
+        }
+    }
+    for (int row = clusterSize - 1; row + 1 < rows; row += clusterSize) {
+        for (int col = 0; col < cols; col += clusterSize) {
+            addEntrances(row * cols + col, 1, min(clusterSize, cols - col), 0, transitions, links, linkCosts);
+        }
+    }
+
+    // Number transition cells by cluster.
+    for (int cluster = 0; cluster < getClusterCount(); cluster++) {
+        clusterOffsets.push_back(vertices.size());
+        int firstRow = (cluster / clusterCols) * clusterSize;
+        int firstCol = (cluster % clusterCols) * clusterSize;
+        for (int row = firstRow; row < min(firstRow + clusterSize, rows); row++) {
+            for (int col = firstCol; col < min(firstCol + clusterSize, cols); col++) {
+                if (!transitions[row * cols + col]) { continue; }
+                nodes[row * cols + col] = vertices.size();
+                vertices.push_back(row * cols + col);
+            }
+        }
+    }
+    clusterOffsets.push_back(vertices.size());
+
+    // Link the nodes of each cluster by their distances within it.
+    SearchContext context(grid.size());
+    for (int cluster = 0; cluster < getClusterCount(); cluster++) {
+        for (int from = getClusterBegin(cluster); from < getClusterEnd(cluster); from++) {
+            searchCluster(vertices[from], -1, false, context);
+            for (int to = getClusterBegin(cluster); to < getClusterEnd(cluster); to++) {
+                if (to == from || context.getState().getState(vertices[to]) != GraphNodeRecordState::closed) { continue; }
+                links.push_back(vertices[from]);
+                links.push_back(vertices[to]);
+                linkCosts.push_back(context.getState().getCostSoFar(vertices[to]));
+            }
+        }
+    }
+
+    // Group the links by their start node.
+    offsets.assign(size() + 1, 0);
+    for (int i = 0; i < (int)linkCosts.size(); i++) { offsets[nodes[links[2 * i]] + 1]++; }
+    for (int node = 0; node < size(); node++) { offsets[node + 1] += offsets[node]; }
+    targets.resize(linkCosts.size());
+    costs.resize(linkCosts.size());
+    vector<int> next(offsets.begin(), offsets.end() - 1);
+    for (int i = 0; i < (int)linkCosts.size(); i++) {
+        int slot = next[nodes[links[2 * i]]]++;
+        targets[slot] = nodes[links[2 * i + 1]];
+        costs[slot] = linkCosts[i];
+    }
+}
+
+void ClusterGraph::addEntrances(int first, int step, int length, int k, vector<bool>& transitions, vector<int>& links, vector<float>& linkCosts) const {
+    int offset = grid->getOffset(k);
+    int i = 0;
+    while (i < length) {
+
+        // A pair of facing cells is crossable if either has an edge to the other.
+        int a = first + i * step;
+        if (!grid->hasEdge(a, k) && !grid->hasEdge(a + offset, 3 - k)) { i++; continue; }
+
+        // The entrance goes on while pairs cross the same ways at the same costs and each side
+        // stays connected both ways along the border, so any crossing can move to its transition.
+        int along = (step == 1) ? 1 : 0;
+        int end = i;
+        while (end + 1 < length) {
+            int from = first + end * step;
+            int next = from + step;
+            if (grid->hasEdge(next, k) != grid->hasEdge(from, k)) { break; }
+            if (grid->hasEdge(next + offset, 3 - k) != grid->hasEdge(from + offset, 3 - k)) { break; }
+            if (grid->getCost(next) != grid->getCost(from) || grid->getCost(next + offset) != grid->getCost(from + offset)) { break; }
+            if (!grid->hasEdge(from, along) || !grid->hasEdge(next, 3 - along)) { break; }
+            if (!grid->hasEdge(from + offset, along) || !grid->hasEdge(next + offset, 3 - along)) { break; }
+            end++;
+        }
+
+        // Cross in the middle of a short entrance, at both ends of a long one.
+        vector<int> crossings;
+        if (end - i + 1 < LONG_ENTRANCE) { crossings.push_back((i + end) / 2); }
+        else {
+            crossings.push_back(i);
+            crossings.push_back(end);
+        }
+        for (int crossing : crossings) {
+            int from = first + crossing * step;
+            int to = from + offset;
+            transitions[from] = true;
+            transitions[to] = true;
+            if (grid->hasEdge(from, k)) {
+                links.push_back(from);
+                links.push_back(to);
+                linkCosts.push_back(grid->getCost(to));
+            }
+            if (grid->hasEdge(to, 3 - k)) {
+                links.push_back(to);
+                links.push_back(from);
+                linkCosts.push_back(grid->getCost(from));
+            }
+        }
+        i = end + 1;
+    }
+}
+
+int ClusterGraph::searchCluster(int source, int target, bool backward, SearchContext& context) const {
+    int cols = grid->getCols();
+    int cluster = getCluster(source);
+    int firstRow = (cluster / clusterCols) * clusterSize;
+    int firstCol = (cluster % clusterCols) * clusterSize;
+
+    // Setup open list and per-vertex state (both indexed by vertex).
+    context.reset();
+    SearchState& state = context.getState();
+    IndexedPriorityQueue& openList = context.getOpenList();
+    state.setCostSoFar(source, 0);
+    state.setParent(source, -1);
+    state.setState(source, GraphNodeRecordState::open);
+    openList.push(source, 0);
+    int closedCount = 0;
+
+    // Run through open list till empty (or the target is found).
+    while (!openList.isEmpty()) {
+        int current = openList.pop();
+        state.setState(current, GraphNodeRecordState::closed);
+        closedCount++;
+        if (current == target) { break; }
+
+        // Relax the edges to (or, backwards, from) neighbors in the cluster.
+        int row = current / cols;
+        int col = current % cols;
+        float currentCSF = state.getCostSoFar(current);
+        for (int k = 0; k < 4; k++) {
+            int neighborRow = row + DIRECTIONS[k][0];
+            int neighborCol = col + DIRECTIONS[k][1];
+            if (neighborRow < firstRow || neighborRow >= firstRow + clusterSize || neighborRow >= grid->getRows()) { continue; }
+            if (neighborCol < firstCol || neighborCol >= firstCol + clusterSize || neighborCol >= cols) { continue; }
+            int neighbor = neighborRow * cols + neighborCol;
+            if (backward ? !grid->hasEdge(neighbor, 3 - k) : !grid->hasEdge(current, k)) { continue; }
+            float neighborCSF = currentCSF + grid->getCost(backward ? current : neighbor);
+
+            GraphNodeRecordState neighborState = state.getState(neighbor);
+            if (neighborState == GraphNodeRecordState::closed) { continue; }
+            if (neighborState == GraphNodeRecordState::unvisited) {
+                state.setCostSoFar(neighbor, neighborCSF);
+                state.setParent(neighbor, current);
+                state.setState(neighbor, GraphNodeRecordState::open);
+                openList.push(neighbor, neighborCSF);
+            }
+            else if (neighborCSF < state.getCostSoFar(neighbor)) {
+                state.setCostSoFar(neighbor, neighborCSF);
+                state.setParent(neighbor, current);
+                openList.decreaseKey(neighbor, neighborCSF);
+            }
+        }
+    }
+    return closedCount;
+}
@@ -0,0 +1,104 @@
+#ifndef CLUSTER_GRAPH_H
+#define CLUSTER_GRAPH_H
+
+#include <cstdlib>
+#include <vector>
+#include "../graph/graph.h"
+#include "../graph/gridgraph.h"
+#include "searchcontext.h"
+
+using namespace std;
+
+/**
+ * Abstract graph of a level grid for hierarchical path finding (HPA*). The grid is split into
+ * square clusters. Every maximal run of alike crossable cell pairs along the border of two
+ * clusters is an entrance, crossed by one transition in its middle, or one at each end if the
+ * run is long. Both cells of a transition are nodes of the abstract graph, linked by an edge across
+ * the border. Inside each cluster, every node has an edge to every node it reaches without
+ * leaving the cluster, costing the shortest such distance (precomputed).
+ *
+ * Nodes are numbered by cluster, so the nodes of one cluster are contiguous. The grid graph
+ * is not copied and must outlive the cluster graph.
+ */
+class ClusterGraph
+{
+    private:
+
+    /** Grid the clusters are over. */
+    const GridGraph* grid;
+
+    /** Number of rows and columns of cells per cluster. */
+    int clusterSize;
+
+    /** Number of rows and columns of clusters. */
+    int clusterRows;
+    int clusterCols;
+
+    /** Grid vertex of each node. */
+    vector<int> vertices;
+
+    /** Start of each cluster's nodes (size cluster count + 1). */
+    vector<int> clusterOffsets;
+
+    /** Node of each grid vertex (-1 for none). */
+    vector<int> nodes;
+
+    /** Edges of the abstract graph in compressed sparse row form (see Graph). */
+    vector<int> offsets;
+    vector<int> targets;
+    vector<float> costs;
+
+    /** Adds transitions for the entrances along a border of length cells starting at vertex first. */
+    void addEntrances(int first, int step, int length, int k, vector<bool>& transitions, vector<int>& links, vector<float>& linkCosts) const;
+
+    public:
+
+    /** Entrances at least this long get two transitions instead of one. */
+    static const int LONG_ENTRANCE = 6;
+
+    /** Builds the abstract graph of grid with clusters of clusterSize x clusterSize cells. */
+    ClusterGraph(const GridGraph& grid, int clusterSize);
+
+    /** Returns the outgoing edges of the node (does not allocate). */
+    inline EdgeRange getOutgoingEdges(int node) const {
+        int first = offsets[node];
+        return EdgeRange(node, targets.data() + first, costs.data() + first, offsets[node + 1] - first);
+    }
+
+    /** Returns the cluster the grid vertex is in. */
+    inline int getCluster(int vertex) const {
+        return (vertex / grid->getCols() / clusterSize) * clusterCols + (vertex % grid->getCols()) / clusterSize;
+    }
+
+    /** Returns true if the clusters are the same or touch (including diagonally). */
+    inline bool isAdjacent(int cluster, int other) const {
+        return abs(cluster / clusterCols - other / clusterCols) <= 1 && abs(cluster % clusterCols - other % clusterCols) <= 1;
+    }
+
+    /** Returns the first node of the cluster (its nodes are [first, getClusterEnd(cluster))). */
+    inline int getClusterBegin(int cluster) const { return clusterOffsets[cluster]; }
+    inline int getClusterEnd(int cluster) const { return clusterOffsets[cluster + 1]; }
+
+    /** Returns the grid vertex of the node. */
+    inline int getVertex(int node) const { return vertices[node]; }
+
+    /** Returns the node at the grid vertex, or -1 if it is not a node. */
+    inline int getNode(int vertex) const { return nodes[vertex]; }
+
+    /** Getters. */
+    inline const GridGraph& getGrid() const { return *grid; }
+    inline int getClusterSize() const { return clusterSize; }
+    inline int getClusterCount() const { return clusterRows * clusterCols; }
+    inline int getEdgeCount() const { return targets.size(); }
+    inline int size() const { return vertices.size(); }
+
+    /**
+     * Runs Dijkstra from the grid vertex source over the cells of its cluster only, leaving the
+     * distances and parents in context (backwards along edges if backward is true, giving
+     * distances to source). Stops once target is closed (-1 searches the whole cluster).
+     * Returns the number of closed vertices.
+     */
+    int searchCluster(int source, int target, bool backward, SearchContext& context) const;
+};
+
+#endif
@@ -0,0 +1,180 @@
+#include <vector>
+#include <algorithm>
+#include "../graph/graph.h"
+#include "searchcontext.h"
+#include "search.h"
+#include "a*.h"
+#include "hpa.h"
+#include "corridorgraph.h"
+
+using namespace std;
+
+CorridorGraph::CorridorGraph(const GraphHandle& graph) : graph(graph) {
+    const Graph& original = *graph;
+    vector<int> inDegree(original.size(), 0);
+    for (int vertex = 0; vertex < original.size(); vertex++) {
+        auto edges = original.getOutgoingEdges(vertex);
+        for (int i = 0; i < edges.size(); i++) { inDegree[edges.target(i)]++; }
+    }
+
+    // Corridor vertices have two distinct neighbors, with edges both ways to each and no others.
+    corridor.assign(original.size(), false);
+    for (int vertex = 0; vertex < original.size(); vertex++) {
+        auto edges = original.getOutgoingEdges(vertex);
+        if (edges.size() != 2 || inDegree[vertex] != 2) { continue; }
+        int a = edges.target(0);
+        int b = edges.target(1);
+        corridor[vertex] = a != b && a != vertex && b != vertex && edgeCost(a, vertex) >= 0 && edgeCost(b, vertex) >= 0;
+    }
+
+    // Every other vertex with an outgoing edge is a node (vertices only entered, like walls, are left out).
+    nodes.assign(original.size(), -1);
+    for (int vertex = 0; vertex < original.size(); vertex++) {
+        if (corridor[vertex] || original.getOutgoingEdges(vertex).isEmpty()) { continue; }
+        nodes[vertex] = vertices.size();
+        vertices.push_back(vertex);
+    }
+
+    // Each edge of a node starts a chain, walked to the node at its other end (loops and edges into
+    // vertices that are not nodes are dropped, as a corridor never leads into one).
+    offsets.reserve(vertices.size() + 1);
+    offsets.push_back(0);
+    for (int node = 0; node < size(); node++) {
+        int vertex = vertices[node];
+        auto edges = original.getOutgoingEdges(vertex);
+        for (int i = 0; i < edges.size(); i++) {
+            float cost;
+            int end = walk(vertex, edges.target(i), -1, false, cost, nullptr);
+            if (end == vertex || nodes[end] == -1) { continue; }
+            targets.push_back(nodes[end]);
+            costs.push_back(cost);
+        }
+        offsets.push_back(targets.size());
+    }
+}
+
+float CorridorGraph::edgeCost(int from, int to) const {
+    float cost = -1;
+    auto edges = graph->getOutgoingEdges(from);
+    for (int i = 0; i < edges.size(); i++) {
+        if (edges.target(i) == to && (cost < 0 || edges.cost(i) < cost)) { cost = edges.cost(i); }
+    }
+    return cost;
+}
+
+int CorridorGraph::walk(int from, int first, int stop, bool backward, float& cost, Path* cells) const {
+    const Graph& original = *graph;
+    cost = backward ? edgeCost(first, from) : edgeCost(from, first);
+    if (cells != nullptr) { cells->add(original.localize(first)); }
+
+    // A corridor vertex leads on to whichever of its two neighbors it was not entered from.
+    int previous = from;
+    int current = first;
+    while (current != stop && corridor[current]) {
+        auto edges = original.getOutgoingEdges(current);
+        int i = edges.target(0) == previous ? 1 : 0;
+        int next = edges.target(i);
+        cost += backward ? edgeCost(next, current) : edges.cost(i);
+        previous = current;
+        current = next;
+        if (cells != nullptr) { cells->add(original.localize(current)); }
+        if (current == from) { return corridor[from] ? -1 : from; }
+    }
+    return current;
+}
+
+void CorridorGraph::expand(const Path& waypoints, int i, Path& cells) const {
+    const Graph& original = *graph;
+    int from = original.index(waypoints.getLocation(i));
+    int to = original.index(waypoints.getLocation(i + 1));
+    if (from == to) {
+        cells.add(original.localize(to));
+        return;
+    }
+
+    // Take the cheapest corridor out of from that ends at to (there may be parallel ones).
+    auto edges = original.getOutgoingEdges(from);
+    int first = -1;
+    float best = 0;
+    for (int j = 0; j < edges.size(); j++) {
+        float cost;
+        if (walk(from, edges.target(j), to, false, cost, nullptr) == to && (first == -1 || cost < best)) {
+            first = edges.target(j);
+            best = cost;
+        }
+    }
+    if (first != -1) { walk(from, first, to, false, best, &cells); }
+}
+
+void CorridorGraph::expand(const Path& waypoints, Path& cells) const {
+    cells.clear();
+    if (waypoints.isEmpty()) { return; }
+    cells.add(waypoints.getLocation(0));
+    for (int i = 0; i + 1 < waypoints.size(); i++) { expand(waypoints, i, cells); }
+    cells.exploredNodes = waypoints.exploredNodes;
+}
+
+CorridorQueryGraph::CorridorQueryGraph(const CorridorGraph& corridors, int startVertex, int endVertex) :
+    corridors(&corridors), startVertex(startVertex), endVertex(endVertex), startCount(0), goalEnds{-1, -1}, goalCosts{0, 0},
+    directCost(-1), goalEntered(corridors.getNode(endVertex) == -1 && !corridors.isCorridor(endVertex)) {
+    const Graph& graph = corridors.getGraph();
+
+    // A start in a corridor links to both ends, or straight to the goal if it is on the way.
+    if (corridors.isCorridor(startVertex)) {
+        auto edges = graph.getOutgoingEdges(startVertex);
+        for (int i = 0; i < edges.size(); i++) {
+            float cost;
+            int end = corridors.walk(startVertex, edges.target(i), endVertex, false, cost, nullptr);
+            if (end == -1) { continue; }
+            if (end == endVertex) {
+                directCost = directCost < 0 ? cost : min(directCost, cost);
+                continue;
+            }
+            startTargets[startCount] = corridors.getNode(end);
+            startCosts[startCount++] = cost;
+        }
+    }
+
+    // A goal in a corridor is linked to from both ends (walked from the goal, costed backward).
+    if (corridors.isCorridor(endVertex)) {
+        int stop = corridors.isCorridor(startVertex) ? startVertex : -1;
+        auto edges = graph.getOutgoingEdges(endVertex);
+        for (int i = 0; i < edges.size(); i++) {
+            float cost;
+            int end = corridors.walk(endVertex, edges.target(i), stop, true, cost, nullptr);
+            if (end == -1 || end == stop) { continue; }
+            int node = corridors.getNode(end);
+            if (goalEnds[0] == -1 || goalEnds[0] == node) {
+                goalCosts[0] = goalEnds[0] == -1 ? cost : min(goalCosts[0], cost);
+                goalEnds[0] = node;
+            }
+            else {
+                goalEnds[1] = node;
+                goalCosts[1] = cost;
+            }
+        }
+    }
+}
+
+void CorridorSearch::search(const CorridorGraph& corridors, const Location& start, const Location& end, const Heuristic& heuristic,
+    SearchContext& context, Path& waypoints) {
+    waypoints.clear();
+
+    // Locations outside of the graph have no path.
+    const Graph& graph = corridors.getGraph();
+    if (!graph.contains(start) || !graph.contains(end)) { return; }
+
+    // A path to itself is start and end; vertices without outgoing edges reach nothing else.
+    int startVertex = graph.index(start);
+    int endVertex = graph.index(end);
+    if (startVertex == endVertex) {
+        waypoints.add(start);
+        waypoints.add(end);
+        return;
+    }
+    bool startLinked = corridors.isCorridor(startVertex) || corridors.getNode(startVertex) != -1;
+    if (!startLinked) { return; }
+
+    CorridorQueryGraph query(corridors, startVertex, endVertex);
+    AStar::search(query, start, end, heuristic, context, waypoints);
+}
@@ -0,0 +1,180 @@
+#ifndef CORRIDOR_GRAPH_H
+#define CORRIDOR_GRAPH_H
+
+#include <vector>
+#include "../graph/graph.h"
+#include "search.h"
+#include "hpa.h"
+
+using namespace std;
+
+/**
+ * Graph with its corridors contracted. A corridor vertex has exactly two neighbors, with edges
+ * both ways to each (most cells of a maze). Every other vertex with an outgoing edge (junctions,
+ * dead ends, rooms) is kept as a node, so there are never more nodes than such vertices. Vertices
+ * only entered (like walls) are left out and become a query's goal node when asked for. Every chain of corridor vertices between two nodes becomes one edge
+ * costing the whole chain. Only the first vertex of each chain is needed to expand it back
+ * into cells, since a corridor can only be walked one way; the walk runs on the original
+ * graph, which the handle keeps alive.
+ */
+class CorridorGraph
+{
+    private:
+
+    /** The original graph. */
+    GraphHandle graph;
+
+    /** True for corridor vertices. */
+    vector<bool> corridor;
+
+    /** Original vertex of each node. */
+    vector<int> vertices;
+
+    /** Node of each original vertex (-1 for corridor vertices and vertices without outgoing edges). */
+    vector<int> nodes;
+
+    /** Edges between nodes in compressed sparse row form (see Graph). */
+    vector<int> offsets;
+    vector<int> targets;
+    vector<float> costs;
+
+    public:
+
+    /** Contracts the corridors of graph. */
+    CorridorGraph(const GraphHandle& graph);
+
+    /** Returns the cost of the cheapest edge between two original vertices (-1 if there is none). */
+    float edgeCost(int from, int to) const;
+
+    /**
+     * Walks from vertex from through first along the corridor until a node or stop is reached.
+     * Returns the vertex reached (-1 if the corridor loops back to from) and sets cost to the cost of
+     * the walk, or of walking it back if backward. Adds every vertex after from to cells if not null.
+     */
+    int walk(int from, int first, int stop, bool backward, float& cost, Path* cells) const;
+
+    /**
+     * Adds the cells of segment i of a path found on this graph (waypoints i and i + 1, which
+     * are nodes or a start or goal in a corridor) to cells, leaving out waypoint i.
+     */
+    void expand(const Path& waypoints, int i, Path& cells) const;
+
+    /** Fills cells with every cell of a path found on this graph. */
+    void expand(const Path& waypoints, Path& cells) const;
+
+    /** Returns the outgoing edges of the node (does not allocate). */
+    inline EdgeRange getOutgoingEdges(int node) const {
+        int first = offsets[node];
+        return EdgeRange(node, targets.data() + first, costs.data() + first, offsets[node + 1] - first);
+    }
+
+    /** Returns true if the original vertex is a corridor vertex. */
+    inline bool isCorridor(int vertex) const { return corridor[vertex]; }
+
+    /** Returns the original vertex of the node. */
+    inline int getVertex(int node) const { return vertices[node]; }
+
+    /** Returns the node of the original vertex (-1 if it is not a node). */
+    inline int getNode(int vertex) const { return nodes[vertex]; }
+
+    /** Getters. */
+    inline const Graph& getGraph() const { return *graph; }
+    inline int getEdgeCount() const { return targets.size(); }
+    inline int size() const { return vertices.size(); }
+};
+
+/**
+ * A CorridorGraph with one query's start and goal inserted. A start or goal that is a node is
+ * used as is; one inside a corridor becomes an extra node (numbered after the corridor graph's
+ * nodes) linked to the two ends of its corridor, and to the other if both share a corridor.
+ * A goal without outgoing edges becomes the extra goal node, linked to from each node entering it.
+ * Has the interface the searches need, so the search is AStar::search.
+ */
+class CorridorQueryGraph
+{
+    private:
+
+    /** Corridor graph the query runs on. */
+    const CorridorGraph* corridors;
+
+    /** Original vertices of the start and goal. */
+    int startVertex;
+    int endVertex;
+
+    /** Edges from the start if it is in a corridor. */
+    int startTargets[2];
+    float startCosts[2];
+    int startCount;
+
+    /** Ends of the goal's corridor and their costs to it (-1 for none). */
+    int goalEnds[2];
+    float goalCosts[2];
+
+    /** Cost from start to goal within their shared corridor (-1 if none). */
+    float directCost;
+
+    /** True if the goal is neither a node nor in a corridor (only entered, like a wall). */
+    bool goalEntered;
+
+    public:
+
+    /** Inserts start and goal into corridors. */
+    CorridorQueryGraph(const CorridorGraph& corridors, int startVertex, int endVertex);
+
+    /** Returns the node of the start and goal. */
+    inline int getStart() const { return corridors->isCorridor(startVertex) ? corridors->size() : corridors->getNode(startVertex); }
+    inline int getGoal() const { return corridors->getNode(endVertex) == -1 ? corridors->size() + 1 : corridors->getNode(endVertex); }
+
+    /** Returns the outgoing edges of the node. */
+    inline AbstractEdgeRange getOutgoingEdges(int node) const {
+        int goal = getGoal();
+        if (node == corridors->size()) {
+            EdgeRange edges(node, startTargets, startCosts, startCount);
+            return AbstractEdgeRange(edges, directCost >= 0 ? goal : -1, directCost);
+        }
+        if (node == corridors->size() + 1) { return AbstractEdgeRange(EdgeRange(node, nullptr, nullptr, 0), -1, 0); }
+        if (goalEntered) {
+            float cost = corridors->edgeCost(corridors->getVertex(node), endVertex);
+            return AbstractEdgeRange(corridors->getOutgoingEdges(node), cost >= 0 ? goal : -1, cost);
+        }
+        for (int i = 0; i < 2; i++) {
+            if (goalEnds[i] == node) { return AbstractEdgeRange(corridors->getOutgoingEdges(node), goal, goalCosts[i]); }
+        }
+        return AbstractEdgeRange(corridors->getOutgoingEdges(node), -1, 0);
+    }
+
+    /** Maps node to the location of its vertex. */
+    inline Location localize(int node) const {
+        const Graph& graph = corridors->getGraph();
+        if (node == corridors->size()) { return graph.localize(startVertex); }
+        if (node == corridors->size() + 1) { return graph.localize(endVertex); }
+        return graph.localize(corridors->getVertex(node));
+    }
+
+    /** Maps the start location to the start node and any other location to the goal node. */
+    inline int index(const Location& location) const {
+        return corridors->getGraph().index(location) == startVertex ? getStart() : getGoal();
+    }
+
+    /** Returns true if the location is a tile of the graph. */
+    inline bool contains(const Location& location) const { return corridors->getGraph().contains(location); }
+
+    /** Returns the number of nodes. */
+    inline int size() const { return corridors->size() + 2; }
+};
+
+/** A* over contracted corridors: searches only junctions and dead ends, expanding the path after. */
+class CorridorSearch
+{
+    public:
+
+    /**
+     * Finds the path from start to end into waypoints (the nodes it passes, plus start and end),
+     * reusing context and path storage; CorridorGraph::expand turns it into cells on demand.
+     * The context must have been constructed for the corridor graph's size plus two.
+     */
+    static void search(const CorridorGraph& corridors, const Location& start, const Location& end, const Heuristic& heuristic,
+        SearchContext& context, Path& waypoints);
+};
+
+#endif
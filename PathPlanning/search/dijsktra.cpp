@@ -1,90 +1,101 @@
 #include "../graph/graph.h"
+#include "../graph/gridgraph.h"
+#include "priorityqueue.h"
+#include "bucketqueue.h"
+#include "searchstate.h"
+#include "searchcontext.h"
 #include "search.h"
 #include "dijsktra.h"
 
-#include <iostream>
 using namespace std;
 
-Dijkstra::Dijkstra(const Graph& graph, const Location& start, const Location& end) : Search(graph, start, end) {
+Dijkstra::Dijkstra(const GraphHandle& graph, const Location& start, const Location& end) : Search(graph, start, end) {
 }
 
 Path Dijkstra::search() const {
+    SearchContext context(getGraph().size());
+    Path path;
+    search(getGraph(), getStart(), getEnd(), context, path);
+    return path;
+}
+
+template <class G>
+void Dijkstra::search(const G& graph, const Location& start, const Location& end, SearchContext& context, Path& path,
+    DijkstraQueue queue) {
+    path.clear();
 
-    // Setup open and closed list.
-    GraphNodeRecord start(Search::quantize(Search::getStart()), GraphNodeRecordState::visited);
-    GraphNodeRecord end(Search::quantize(Search::getEnd()), GraphNodeRecordState::unvisited);
-    Path openList;
-    openList.add(start);
-    Path closedList;
+    // Locations outside of the graph have no path.
+    if (!graph.contains(start) || !graph.contains(end)) { return; }
+    context.reset();
+
+    // Integer costs keep every queued CSF within maxCost of the smallest, which buckets exploit.
+    int maxCost = graph.getMaxIntegerCost();
+    bool buckets = maxCost >= 0 && (queue == BUCKET_QUEUE || (queue == AUTO_QUEUE && maxCost <= MAX_BUCKET_COST));
+    if (buckets) {
+        run(graph, graph.index(start), graph.index(end), context.getState(), context.getBucketQueue(maxCost), path);
+    }
+    else {
+        run(graph, graph.index(start), graph.index(end), context.getState(), context.getOpenList(), path);
+    }
+}
+
+template <class G, class Q>
+void Dijkstra::run(const G& graph, int startVertex, int endVertex, SearchState& state, Q& openList, Path& path) {
+
+    // Setup open list and per-vertex state (both indexed by vertex).
+    state.setCostSoFar(startVertex, 0);
+    state.setState(startVertex, GraphNodeRecordState::open);
+    openList.push(startVertex, 0);
+    int closedCount = 0;
 
     // Run through open list till empty.
-    GraphNodeRecord current = openList.getSmallestCSF();
     while (!openList.isEmpty()) {
 
         // Find smallest element in open list.
-        GraphNodeRecord current = openList.getSmallestCSF();
+        int current = openList.pop();
 
         // Found the end.
-        if (current.getLocation() == Search::getEnd()) {
-            vector<GraphNodeRecord> pathList;
-            while (!(current.getLocation() == Search::getStart())) {
-                pathList.push_back(current);
-                current = closedList.find(current.getEdge().getFromVertex()); // Closed list is essentially the path...
-            }
-            // cout << "PATHLIST SIZE: " << pathList.size() << endl;
-            // for (const auto& record : pathList) { cout << record.getLocation().x << " " << record.getLocation().y << endl; }
-
-            // Return reversed path list as a Path.
-            // TODO: Why do I have to add start and end records?
-            Path path;
-            path.add(start);
-            for (int i = pathList.size() - 1; i > 0; i--) { path.add(pathList[i]); }
-            path.add(end);
-            path.exploredNodes = closedList.size();
-            return path;
+        if (current == endVertex) {
+            state.toPath(graph, startVertex, endVertex, closedCount, path);
+            return;
         }
 
-        // Otherwise get its outgoing edges. // TODO: could fail.
-        vector<Edge> edges = Search::getGraph().getOutgoingEdges(current.getNode().getVertex());
+        // Otherwise get its outgoing edges.
+        auto edges = graph.getOutgoingEdges(current);
+        float currentCSF = state.getCostSoFar(current);
 
-        // cout << "\n\n" << current.getLocation().x << " " <<  current.getLocation().y << endl;
         // Find best edge to traverse.
-        for (const auto& edge : edges) {
-
-            auto l = Search::localize(edge.getToVertex());
-            // cout << l.x << " " << l.y << endl;
+        for (int i = 0; i < edges.size(); i++) {
 
             // Get end node and it's cost so far (CSF).
-            GraphNode endNode = Search::getGraph().getNode(edge.getToVertex());
-            float endNodeCSF = current.getCostSoFar() + edge.getCost();
+            int endNode = edges.target(i);
+            float endNodeCSF = currentCSF + edges.cost(i);
+            GraphNodeRecordState endNodeState = state.getState(endNode);
 
-            // Skip nodes on closed list.
-            if (closedList.contains(endNode)) {
+            // Otherwise know node is unvisited, thus make new record.
+            if (endNodeState == GraphNodeRecordState::unvisited) {
+                state.setCostSoFar(endNode, endNodeCSF);
+                state.setParent(endNode, current);
+                state.setState(endNode, GraphNodeRecordState::open);
+                openList.push(endNode, endNodeCSF);
                 continue;
             }
 
-            // On open means worse route.
-            else if (openList.contains(endNode)) {
-
-                // If current route yields worse CSF, skip this edge.
-                GraphNodeRecord endNodeRecord = openList.find(endNode);
-                if (endNodeRecord.getCostSoFar() <= endNodeCSF) {
-                    continue;
-                }
-            }
+            // Skip nodes on closed list.
+            if (endNodeState == GraphNodeRecordState::closed) { continue; }
 
-            // Otherwise know node is unvisited, thus make new record.
-            else {
-                GraphNodeRecord endNodeRecord(endNode, GraphNodeRecordState::visited);
-                endNodeRecord.setCostSoFar(endNodeCSF);
-                endNodeRecord.setEdge(edge);
-                if (!openList.contains(endNode)) { openList.add(endNodeRecord); }
-            }
+            // On open means worse route, unless current route yields better CSF.
+            if (state.getCostSoFar(endNode) <= endNodeCSF) { continue; }
+            state.setCostSoFar(endNode, endNodeCSF);
+            state.setParent(endNode, current);
+            openList.decreaseKey(endNode, endNodeCSF);
         }
 
         // Finished viewing edges for current.
-        openList.remove(current);
-        closedList.add(current);
+        state.setState(current, GraphNodeRecordState::closed);
+        closedCount++;
     }
-    return Path();
 }
+
+template void Dijkstra::search<Graph>(const Graph&, const Location&, const Location&, SearchContext&, Path&, DijkstraQueue);
+template void Dijkstra::search<GridGraph>(const GridGraph&, const Location&, const Location&, SearchContext&, Path&, DijkstraQueue);
@@ -2,17 +2,44 @@
 #define DIJSKTRA_H
 
 #include "search.h"
+#include "searchcontext.h"
+
+/** Open lists Dijkstra's search can keep its frontier in. */
+enum DijkstraQueue
+{
+    AUTO_QUEUE,     // Bucket queue if edge costs are small integers, binary heap otherwise.
+    HEAP_QUEUE,     // Binary heap (any non-negative costs).
+    BUCKET_QUEUE    // Bucket queue (falls back to the heap if costs are not integers).
+};
 
 /** Represents Dijkstra's search algorithm. */
 class Dijkstra : public Search
 {
+    private:
+
+    /** Searches from start to end vertex with the given open list (a heap or a bucket queue). */
+    template <class G, class Q>
+    static void run(const G& graph, int startVertex, int endVertex, SearchState& state, Q& openList, Path& path);
 
     public:
+
+    /** Largest edge cost for which AUTO_QUEUE picks the bucket queue (one bucket per cost). */
+    static const int MAX_BUCKET_COST = 1024;
+
     /** Default constructor. */
-    Dijkstra(const Graph& graph, const Location& start, const Location& end);
+    Dijkstra(const GraphHandle& graph, const Location& start, const Location& end);
 
     /** Returns path from start location to end location in graph. */
     Path search() const;
+
+    /**
+     * Finds the path from start to end in graph into path, reusing context and path storage.
+     * The context must have been constructed for graph's size. Does not copy the graph.
+     * Defined for Graph and GridGraph.
+     */
+    template <class G>
+    static void search(const G& graph, const Location& start, const Location& end, SearchContext& context, Path& path,
+        DijkstraQueue queue = AUTO_QUEUE);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,143 @@
+#ifndef DSTAR_LITE_H
+#define DSTAR_LITE_H
+
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include "../graph/graph.h"
+#include "search.h"
+
+using namespace std;
+
+/**
+ * D* Lite incremental planner for a searcher chasing a goal on a level's graph. It searches
+ * backwards from the goal and keeps its search tree (each vertex's cost to the goal g and
+ * one-step lookahead rhs) between plans, so a new plan only repairs the vertices whose cost to
+ * the goal changed: none when only the start moved, those around a moved goal, and those
+ * downstream of changed edges.
+ *
+ * Keys are [min(g, rhs) + h + km, min(g, rhs)] with h the manhattan distance to the start,
+ * which is consistent on levels (4-connected, every edge costs at least 1). As the start moves,
+ * km accumulates the distance it moved instead of re-keying the queue, which keeps every queued
+ * key a lower bound of its current key.
+ */
+class DStarLite
+{
+    private:
+
+    /** Two-part priority of a vertex, ordered lexicographically. */
+    struct Key
+    {
+        float first;
+        float second;
+
+        inline bool operator<(const Key& other) const {
+            return first < other.first || (first == other.first && second < other.second);
+        }
+    };
+
+    /** Indexed binary min-heap of vertices keyed by Key, whose keys may move either way. */
+    class KeyQueue
+    {
+        private:
+
+        /** A queued vertex and its key. */
+        struct Entry
+        {
+            Key key;
+            int vertex;
+        };
+
+        /** Entries in heap order. */
+        vector<Entry> heap;
+
+        /** Position of each vertex in the heap (-1 if not queued). */
+        vector<int> position;
+
+        /** Moves the entry at index i up or down until the heap property holds. */
+        void siftUp(int i);
+        void siftDown(int i);
+
+        public:
+
+        /** Constructs an empty queue for vertices in [0, capacity). */
+        KeyQueue(int capacity);
+
+        /** Getters. */
+        inline bool contains(int vertex) const { return position[vertex] != -1; }
+        inline int top() const { return heap[0].vertex; }
+        inline Key topKey() const { return heap.empty() ? Key{ INFINITY, INFINITY } : heap[0].key; }
+
+        /** Queues a vertex that is not queued yet. */
+        void push(int vertex, const Key& key);
+
+        /** Changes the key of a queued vertex. */
+        void update(int vertex, const Key& key);
+
+        /** Removes a queued vertex. */
+        void remove(int vertex);
+
+        /** Removes every queued vertex. */
+        void clear();
+    };
+
+    /** Graph planned on and its transpose (for the predecessors of a vertex). */
+    GraphHandle graph;
+    Graph reverse;
+
+    /** Cost to the goal of each vertex, and its one-step lookahead. */
+    vector<float> g;
+    vector<float> rhs;
+
+    /** Locally inconsistent vertices (g != rhs). */
+    KeyQueue openList;
+
+    /** Goal and start of the last plan (-1 before the first), and accumulated key offset. */
+    int goal;
+    int start;
+    float km;
+
+    /** Returns the manhattan distance between two vertices. */
+    inline float heuristic(int from, int to) const {
+        Location a = graph->localize(from);
+        Location b = graph->localize(to);
+        return abs(a.x - b.x) + abs(a.y - b.y);
+    }
+
+    /** Returns the current key of a vertex. */
+    inline Key calculateKey(int vertex) const {
+        float cost = min(g[vertex], rhs[vertex]);
+        return Key{ cost + heuristic(start, vertex) + km, cost };
+    }
+
+    /** Returns the smallest cost to the goal through the vertex's outgoing edges. */
+    float lookahead(int vertex) const;
+
+    /** Queues, re-keys or dequeues the vertex by whether it is locally inconsistent. */
+    void updateVertex(int vertex);
+
+    /** Repairs the search tree until the start is consistent, returning the vertices expanded. */
+    int computeShortestPath();
+
+    public:
+
+    /** Constructs a planner on graph, which must be a graph of a level. */
+    DStarLite(const GraphHandle& graph);
+
+    /**
+     * Fills path with a shortest path from start to goal, repairing the previous plan instead of
+     * searching again. Path's explored nodes are the vertices expanded by the repair.
+     */
+    void plan(const Location& start, const Location& goal, Path& path);
+
+    /**
+     * Replaces the graph with one of the same vertices whose edges changed, where changed lists
+     * every vertex with a changed outgoing edge. The next plan repairs what they affect.
+     */
+    void setGraph(const GraphHandle& graph, const vector<int>& changed);
+
+    /** Forgets the search tree, so the next plan searches from scratch. */
+    void reset();
+};
+
+#endif
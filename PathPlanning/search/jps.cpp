@@ -0,0 +1,172 @@
+#include "../graph/gridgraph.h"
+#include "priorityqueue.h"
+#include "searchstate.h"
+#include "searchcontext.h"
+#include "search.h"
+#include "a*.h"
+#include "jps.h"
+
+using namespace std;
+
+const int JumpPointSearch::PERPENDICULAR[4][2] = { {1, 2}, {0, 3}, {0, 3}, {1, 2} };
+
+int JumpPointSearch::direction(const GridGraph& graph, int from, int to) {
+    if (from / graph.getCols() == to / graph.getCols()) { return to > from ? 1 : 2; }
+    return to > from ? 0 : 3;
+}
+
+int JumpPointSearch::jump(const GridGraph& graph, int vertex, int k, int goal, float& cost) {
+    int previous = vertex;
+    int steps = 0;
+    while (isOpen(graph, previous, k, goal)) {
+        int current = previous + graph.getOffset(k);
+        steps++;
+
+        // Stop at the goal and where the grid stops being uniform.
+        if (current == goal || !graph.isJumpable(current)) {
+            cost = (steps - 1) * graph.getUniformCost() + graph.getCost(current);
+            return current;
+        }
+        cost = steps * graph.getUniformCost();
+
+        // Along a row, stop where a perpendicular neighbor opens up behind an obstacle.
+        if (alongRow(k)) {
+            for (int p : PERPENDICULAR[k]) {
+                if (isOpen(graph, current, p, goal) && !isOpen(graph, previous, p, goal)) { return current; }
+            }
+        }
+
+        // Along a column, stop where a row scan finds a jump point.
+        else {
+            for (int p : PERPENDICULAR[k]) {
+                float scanCost;
+                if (jump(graph, current, p, goal, scanCost) != -1) { return current; }
+            }
+        }
+        previous = current;
+    }
+    return -1;
+}
+
+int JumpPointSearch::successors(const GridGraph& graph, int vertex, int parent, int goal) {
+
+    // Start and cells that are not jumpable search every direction (plain A*).
+    if (parent == -1 || !graph.isJumpable(vertex)) { return 0xF; }
+
+    // Along a column, keep going or turn into a row.
+    int k = direction(graph, parent, vertex);
+    if (!alongRow(k)) { return (1 << k) | (1 << PERPENDICULAR[k][0]) | (1 << PERPENDICULAR[k][1]); }
+
+    // Along a row, keep going or turn where an obstacle forces it.
+    int previous = vertex - graph.getOffset(k);
+    int directions = 1 << k;
+    for (int p : PERPENDICULAR[k]) {
+        if (isOpen(graph, vertex, p, goal) && !isOpen(graph, previous, p, goal)) { directions |= 1 << p; }
+    }
+    return directions;
+}
+
+void JumpPointSearch::toPath(const GridGraph& graph, const SearchState& state, int start, int end, int exploredNodes, Path& path) {
+    path.clear();
+
+    // Add every cell from end back to start, stepping along each jump (a path to itself is start and end).
+    if (start == end) { path.add(graph.localize(end)); }
+    path.add(graph.localize(end));
+    for (int vertex = end; vertex != start; vertex = state.getParent(vertex)) {
+        int parent = state.getParent(vertex);
+        int step = graph.getOffset(direction(graph, vertex, parent));
+        for (int cell = vertex + step; cell != parent; cell += step) { path.add(graph.localize(cell)); }
+        path.add(graph.localize(parent));
+    }
+
+    // Locations were added backwards.
+    path.reverse();
+    path.exploredNodes = exploredNodes;
+}
+
+void JumpPointSearch::search(const GridGraph& graph, const Location& start, const Location& end, const Heuristic& heuristic,
+    SearchContext& context, Path& path) {
+    path.clear();
+
+    // Locations outside of the graph have no path.
+    if (!graph.contains(start) || !graph.contains(end)) { return; }
+
+    // Without jumpable cells every cell is expanded anyway.
+    if (!graph.hasJumpable()) {
+        AStar::search(graph, start, end, heuristic, context, path);
+        return;
+    }
+
+    // Setup open list and per-vertex state (both indexed by vertex).
+    int startVertex = graph.index(start);
+    int endVertex = graph.index(end);
+    context.reset();
+    SearchState& state = context.getState();
+    IndexedPriorityQueue& openList = context.getOpenList();
+    state.setCostSoFar(startVertex, 0);
+    state.setEstimatedTotalCost(startVertex, heuristic.compute(start));
+    state.setParent(startVertex, -1);
+    state.setState(startVertex, GraphNodeRecordState::open);
+    openList.push(startVertex, state.getEstimatedTotalCost(startVertex));
+    int closedCount = 0;
+
+    // Run through open list till empty.
+    while (!openList.isEmpty()) {
+
+        // Find smallest element in open list.
+        int current = openList.pop();
+
+        // Found the end.
+        if (current == endVertex) {
+            toPath(graph, state, startVertex, endVertex, closedCount, path);
+            return;
+        }
+
+        // Otherwise jump in every direction worth searching.
+        int directions = successors(graph, current, state.getParent(current), endVertex);
+        float currentCSF = state.getCostSoFar(current);
+        for (int k = 0; k < 4; k++) {
+            if (!(directions & (1 << k))) { continue; }
+
+            // Get jump point and it's cost so far (CSF).
+            float jumpCost;
+            int endNode = jump(graph, current, k, endVertex, jumpCost);
+            if (endNode == -1) { continue; }
+            float endNodeCSF = currentCSF + jumpCost;
+            GraphNodeRecordState endNodeState = state.getState(endNode);
+
+            // Otherwise know node is unvisited, thus make new record.
+            if (endNodeState == GraphNodeRecordState::unvisited) {
+                state.setCostSoFar(endNode, endNodeCSF);
+                state.setEstimatedTotalCost(endNode, endNodeCSF + heuristic.compute(graph.localize(endNode)));
+                state.setParent(endNode, current);
+                state.setState(endNode, GraphNodeRecordState::open);
+                openList.push(endNode, state.getEstimatedTotalCost(endNode));
+                continue;
+            }
+
+            // If shorter route not found, skip.
+            if (state.getCostSoFar(endNode) <= endNodeCSF) { continue; }
+
+            // Use compute heurisitic for end node (via old values).
+            float endNodeHeuristic = state.getEstimatedTotalCost(endNode) - state.getCostSoFar(endNode);
+            state.setCostSoFar(endNode, endNodeCSF);
+            state.setEstimatedTotalCost(endNode, endNodeCSF + endNodeHeuristic);
+            state.setParent(endNode, current);
+
+            // If shorter route found to a closed node, reopen it.
+            if (endNodeState == GraphNodeRecordState::closed) {
+                state.setState(endNode, GraphNodeRecordState::open);
+                openList.push(endNode, state.getEstimatedTotalCost(endNode));
+                closedCount--;
+            }
+            else {
+                openList.decreaseKey(endNode, state.getEstimatedTotalCost(endNode));
+            }
+        }
+
+        // Finished viewing jumps for current.
+        state.setState(current, GraphNodeRecordState::closed);
+        closedCount++;
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef JPS_H
+#define JPS_H
+
+#include "../graph/gridgraph.h"
+#include "search.h"
+#include "searchcontext.h"
+
+/**
+ * Jump point search on the level grid (four-connected). Instead of expanding every cell of an
+ * open room like A*, it jumps along straight lines and only queues the cells where a shortest
+ * path may have to turn: moving along a row it stops where a cell above or below opens up
+ * behind an obstacle, moving along a column it stops where a row scan finds such a cell.
+ *
+ * Jumps only pass through jumpable cells (see GridGraph). Cells that are not jumpable (other
+ * costs, restricted directions, or next to such cells) are expanded like plain A* would, so
+ * paths stay optimal on weighted levels too. Dead ends other than the goal count as blocked.
+ */
+class JumpPointSearch
+{
+    private:
+
+    /** Directions (indices into Level::NEIGHBORS) perpendicular to each direction. */
+    static const int PERPENDICULAR[4][2];
+
+    /** Returns true if direction k moves along a row (changes the column). */
+    static inline bool alongRow(int k) { return k == 1 || k == 2; }
+
+    /** Returns true if a path to goal may step from vertex in direction k (an edge, not into a dead end). */
+    static inline bool isOpen(const GridGraph& graph, int vertex, int k, int goal) {
+        int target = vertex + graph.getOffset(k);
+        if (graph.isJumpable(vertex)) { return graph.inLevel(target) && (target == goal || graph.hasDirections(target)); }
+        return graph.hasEdge(vertex, k) && (target == goal || !graph.isDeadEnd(target));
+    }
+
+    /** Returns the direction of the straight line from vertex from to vertex to. */
+    static int direction(const GridGraph& graph, int from, int to);
+
+    /**
+     * Returns the first jump point reached moving from vertex in direction k, or -1 if there
+     * is none, and sets cost to the cost of reaching it.
+     */
+    static int jump(const GridGraph& graph, int vertex, int k, int goal, float& cost);
+
+    /** Returns the directions (bit k for direction k) worth searching from vertex reached from parent. */
+    static int successors(const GridGraph& graph, int vertex, int parent, int goal);
+
+    /** Fills path with every cell on the jumps from start to end. */
+    static void toPath(const GridGraph& graph, const SearchState& state, int start, int end, int exploredNodes, Path& path);
+
+    public:
+
+    /**
+     * Finds the path from start to end in graph into path, reusing context and path storage.
+     * The context must have been constructed for graph's size. Explored nodes counts jump points.
+     * Runs A* if the graph was built without jumpable cells.
+     */
+    static void search(const GridGraph& graph, const Location& start, const Location& end, const Heuristic& heuristic,
+        SearchContext& context, Path& path);
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include <vector>
+#include <atomic>
+#include "../graph/graph.h"
+#include "search.h"
+
+using namespace std;
+
+/**
+ * Landmarks for the ALT (A*, landmarks, triangle inequality) heuristic. A few vertices are
+ * chosen as landmarks by farthest-point selection (each is the vertex farthest from the ones
+ * before it), and the path cost from every landmark to every vertex and back is precomputed
+ * with one Dijkstra per landmark and direction, the backward ones spread over threads.
+ *
+ * By the triangle inequality, d(v, t) >= d(L, t) - d(L, v) and d(v, t) >= d(v, L) - d(t, L)
+ * for any landmark L, so the largest of these bounds is an admissible (and consistent)
+ * heuristic that, unlike straight line distances, knows about walls.
+ */
+class Landmarks
+{
+    private:
+
+    /** Vertices chosen as landmarks. */
+    vector<int> landmarks;
+
+    /** Cost from each landmark to each vertex, and from each vertex to each landmark (vertex-major). */
+    vector<float> fromLandmarks;
+    vector<float> toLandmarks;
+
+    /** Shape of the graph. */
+    int rows;
+    int cols;
+
+    /** Runs Dijkstra from each landmark taken from next on graph, writing costs into distances. */
+    template <class G>
+    void fillDistances(const G& graph, atomic<int>* next, vector<float>& distances) const;
+
+    public:
+
+    /**
+     * Chooses count landmarks of graph and computes their costs using the given number of
+     * threads (0 for one per hardware thread). Defined for Graph and GridGraph.
+     */
+    template <class G>
+    Landmarks(const G& graph, int count, int threads = 0);
+
+    /** Returns the cost from landmark i to the vertex (INFINITY if unreachable). */
+    inline float getCostFrom(int i, int vertex) const { return fromLandmarks[vertex * landmarks.size() + i]; }
+
+    /** Returns the cost from the vertex to landmark i (INFINITY if unreachable). */
+    inline float getCostTo(int i, int vertex) const { return toLandmarks[vertex * landmarks.size() + i]; }
+
+    /** Returns the lower bound on the cost from one vertex to another. */
+    float getBound(int from, int to) const;
+
+    /** Returns true if the location is a tile of the graph. */
+    inline bool contains(const Location& location) const {
+        return location.x >= 0 && location.x < rows && location.y >= 0 && location.y < cols;
+    }
+
+    /** Maps location to the dense index of its vertex. */
+    inline int index(const Location& location) const { return location.x * cols + location.y; }
+
+    /** Getters. */
+    inline int getLandmark(int i) const { return landmarks[i]; }
+    inline int size() const { return landmarks.size(); }
+};
+
+/** Landmark (ALT) heuristic: the best triangle inequality bound over all landmarks. */
+class LandmarkHeuristic : public Heuristic
+{
+    private:
+
+    /** Landmarks of the graph searched. */
+    const Landmarks* landmarks;
+
+    /** Vertex of the goal. */
+    int goal;
+
+    public:
+
+    /** Constructs the heuristic towards goal (the landmarks must outlive it). */
+    LandmarkHeuristic(const Landmarks& landmarks, const Location& goal);
+
+    /** Returns heuristic value of location to goal location. */
+    float compute(const Location& location) const;
+};
+
+#endif
@@ -0,0 +1,99 @@
+#include <list>
+#include <iterator>
+#include <typeinfo>
+#include <unordered_map>
+#include "../graph/graph.h"
+#include "searchcontext.h"
+#include "search.h"
+#include "a*.h"
+#include "pathcache.h"
+
+using namespace std;
+
+PathCache::PathCache(const GraphHandle& graph, int capacity) : graph(graph), capacity(capacity), stored(0) {}
+
+void PathCache::setGraph(const GraphHandle& graph) {
+    if (graph == this->graph) { return; }
+    if (!entries.empty()) { stats.invalidations++; }
+    clear();
+    this->graph = graph;
+}
+
+void PathCache::clear() {
+    entries.clear();
+    index.clear();
+    suffixes.clear();
+    stored = 0;
+}
+
+void PathCache::search(const Location& start, const Location& end, const Heuristic& heuristic, bool optimal, SearchContext& context,
+    Path& path) {
+    if (lookup(start, end, heuristic, path)) { return; }
+    AStar::search(*graph, start, end, heuristic, context, path);
+    insert(start, end, heuristic, optimal, path);
+}
+
+bool PathCache::lookup(const Location& start, const Location& end, const Heuristic& heuristic, Path& path) {
+    Key key = { graph->index(start), graph->index(end), typeid(heuristic).hash_code() };
+
+    // Exact hit: move the entry to the front.
+    auto found = index.find(key);
+    if (found != index.end()) {
+        entries.splice(entries.begin(), entries, found->second);
+        path = found->second->path;
+        path.exploredNodes = 0;
+        stats.hits++;
+        return true;
+    }
+
+    // A path to itself is start twice, not the tail of another path, so it is searched.
+    if (key.start == key.end) {
+        stats.misses++;
+        return false;
+    }
+
+    // Suffix hit: an optimal path to the same end through start (O(1) per path to check).
+    Key suffix = { -1, key.end, key.heuristic };
+    auto candidates = suffixes.equal_range(suffix);
+    for (auto candidate = candidates.first; candidate != candidates.second; candidate++) {
+        auto entry = candidate->second;
+        int first = entry->path.find(start);
+        if (first == -1) { continue; }
+        path.clear();
+        for (int i = first; i < entry->path.size(); i++) { path.add(entry->path.getLocation(i)); }
+        entries.splice(entries.begin(), entries, entry);
+        stats.suffixHits++;
+        return true;
+    }
+    stats.misses++;
+    return false;
+}
+
+void PathCache::insert(const Location& start, const Location& end, const Heuristic& heuristic, bool optimal, const Path& path) {
+    Key key = { graph->index(start), graph->index(end), typeid(heuristic).hash_code() };
+    if (path.size() > capacity || index.count(key) != 0) { return; }
+
+    // Cache at the front and evict from the back past capacity.
+    entries.push_front(Entry{ key, optimal, path });
+    index[key] = entries.begin();
+    if (optimal) { suffixes.emplace(Key{ -1, key.end, key.heuristic }, entries.begin()); }
+    stored += path.size();
+    while (stored > capacity) {
+        auto last = prev(entries.end());
+        stored -= last->path.size();
+        index.erase(last->key);
+        if (last->optimal) { eraseSuffix(last); }
+        entries.pop_back();
+        stats.evictions++;
+    }
+}
+
+void PathCache::eraseSuffix(list<Entry>::iterator entry) {
+    auto candidates = suffixes.equal_range(Key{ -1, entry->key.end, entry->key.heuristic });
+    for (auto candidate = candidates.first; candidate != candidates.second; candidate++) {
+        if (candidate->second == entry) {
+            suffixes.erase(candidate);
+            return;
+        }
+    }
+}
@@ -0,0 +1,121 @@
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+
+#include <list>
+#include <unordered_map>
+#include <stddef.h>
+#include "../graph/graph.h"
+#include "search.h"
+#include "searchcontext.h"
+
+using namespace std;
+
+/** Counters of a PathCache. */
+struct PathCacheStats
+{
+    long long hits = 0;
+    long long suffixHits = 0;
+    long long misses = 0;
+    long long evictions = 0;
+    long long invalidations = 0;
+
+    /** Returns the fraction of queries answered without searching. */
+    inline float getHitRate() const {
+        long long queries = hits + suffixHits + misses;
+        return queries == 0 ? 0 : float(hits + suffixHits) / queries;
+    }
+};
+
+/**
+ * Least recently used cache of A* paths on one graph in front of AStar::search, keyed by start
+ * cell, end cell and heuristic (its dynamic type). Memory is bounded by the number of locations stored
+ * across all paths; the least recently used paths are evicted past it.
+ *
+ * A query missing the cache may still be a suffix of a cached optimal path to the same end
+ * (any part of a shortest path is shortest). Optimal paths are indexed by their end, so only the
+ * paths to the query's end are checked, in O(1) each by Path::find. Only
+ * paths of admissible heuristics are marked optimal. Graphs never change, so the cached paths
+ * stay valid until the cache is given another graph (as when its level changed), which drops them all.
+ */
+class PathCache
+{
+    private:
+
+    /** Key of a cached query (start -1 for every query to the end, for suffix lookups). */
+    struct Key
+    {
+        int start;
+        int end;
+        size_t heuristic;
+
+        inline bool operator==(const Key& other) const {
+            return start == other.start && end == other.end && heuristic == other.heuristic;
+        }
+    };
+
+    /** Hash of a key. */
+    struct KeyHash
+    {
+        inline size_t operator()(const Key& key) const {
+            return (size_t(key.start) * 73856093) ^ (size_t(key.end) * 19349663) ^ key.heuristic;
+        }
+    };
+
+    /** A cached query and its path. */
+    struct Entry
+    {
+        Key key;
+        bool optimal;
+        Path path;
+    };
+
+    /** Graph the cached paths were found on. */
+    GraphHandle graph;
+
+    /** Largest number of locations stored across all paths, and the number stored. */
+    int capacity;
+    int stored;
+
+    /** Cached paths, most recently used first, each key's entry, and the optimal entries to each end. */
+    list<Entry> entries;
+    unordered_map<Key, list<Entry>::iterator, KeyHash> index;
+    unordered_multimap<Key, list<Entry>::iterator, KeyHash> suffixes;
+
+    /** Counters. */
+    PathCacheStats stats;
+
+    /** Removes an optimal entry from the paths indexed by end. */
+    void eraseSuffix(list<Entry>::iterator entry);
+
+    public:
+
+    /** Constructs an empty cache for paths on graph holding at most capacity locations. */
+    PathCache(const GraphHandle& graph, int capacity);
+
+    /**
+     * Fills path with the path from start to end on the cache's graph, from the cache when it
+     * has it and otherwise with AStar::search, caching the result. Optimal tells whether the
+     * heuristic is admissible, which lets later queries reuse its suffixes.
+     */
+    void search(const Location& start, const Location& end, const Heuristic& heuristic, bool optimal, SearchContext& context, Path& path);
+
+    /** Fills path from the cache and returns true if it has it, counting a miss otherwise. */
+    bool lookup(const Location& start, const Location& end, const Heuristic& heuristic, Path& path);
+
+    /** Caches a path searched elsewhere from start to end (see search). */
+    void insert(const Location& start, const Location& end, const Heuristic& heuristic, bool optimal, const Path& path);
+
+    /** Caches paths on graph from now on, dropping every path if it is another graph than before. */
+    void setGraph(const GraphHandle& graph);
+
+    /** Drops every path. */
+    void clear();
+
+    /** Getters. */
+    inline const PathCacheStats& getStats() const { return stats; }
+    inline int getStoredLocations() const { return stored; }
+    inline int size() const { return entries.size(); }
+    inline const GraphHandle& getGraph() const { return graph; }
+};
+
+#endif
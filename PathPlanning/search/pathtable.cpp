@@ -0,0 +1,198 @@
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include "../graph/graph.h"
+#include "priorityqueue.h"
+#include "search.h"
+#include "pathtable.h"
+
+using namespace std;
+
+const uint16_t PathTable::UNREACHABLE;
+const uint32_t PathTable::MAGIC;
+const int PathTable::MAX_CELLS;
+const int PathTable::MAX_DISTANCE;
+
+PathTable::PathTable(const GraphHandle& graph, int threads) : graph(graph), key(hash(*graph)) {
+    build(threads);
+}
+
+PathTable::PathTable(const GraphHandle& graph, const string& cacheDirectory, int threads) : graph(graph), key(hash(*graph)) {
+    char name[32];
+    snprintf(name, sizeof(name), "pathtable-%016llx.bin", (unsigned long long)key);
+    string file = cacheDirectory + "/" + name;
+    if (load(file)) { return; }
+    build(threads);
+    save(file);
+}
+
+uint64_t PathTable::hash(const Graph& graph) {
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = (const unsigned char*)data;
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    // Every vertex's edge count, targets and costs (the graph's shape is in its vertex count).
+    int size = graph.size();
+    mix(&size, sizeof(size));
+    for (int vertex = 0; vertex < size; vertex++) {
+        auto edges = graph.getOutgoingEdges(vertex);
+        int count = edges.size();
+        mix(&count, sizeof(count));
+        for (int i = 0; i < count; i++) {
+            int target = edges.target(i);
+            float cost = edges.cost(i);
+            mix(&target, sizeof(target));
+            mix(&cost, sizeof(cost));
+        }
+    }
+    return hash;
+}
+
+void PathTable::build(int threads) {
+    const Graph& graph = *this->graph;
+    cellIndex.assign(graph.size(), -1);
+    for (int vertex = 0; vertex < graph.size(); vertex++) {
+        if (graph.getOutgoingEdges(vertex).isEmpty()) { continue; }
+        cellIndex[vertex] = cells.size();
+        cells.push_back(vertex);
+    }
+    if (size() > MAX_CELLS) {
+        cells.clear();
+        fill(cellIndex.begin(), cellIndex.end(), -1);
+        return;
+    }
+    distances.assign(cells.size() * cells.size(), UNREACHABLE);
+    nextHops.assign(cells.size() * cells.size(), 0);
+
+    // Rows are independent, so threads take the next unfilled one until none are left.
+    if (threads <= 0) { threads = max(1u, thread::hardware_concurrency()); }
+    threads = min(threads, max(1, size()));
+    atomic<int> next(0);
+    vector<thread> workers;
+    for (int i = 1; i < threads; i++) { workers.push_back(thread(&PathTable::buildRows, this, &next)); }
+    buildRows(&next);
+    for (auto& worker : workers) { worker.join(); }
+}
+
+void PathTable::buildRows(atomic<int>* next) {
+    const Graph& graph = *this->graph;
+    int n = size();
+    IndexedPriorityQueue openList(graph.size());
+    vector<float> costSoFar(graph.size());
+    vector<int> firstHop(graph.size());
+
+    while (true) {
+        int source = next->fetch_add(1);
+        if (source >= n) { return; }
+
+        // Dijkstra from the source, tracking the first cell of each vertex's path (its next hop).
+        fill(costSoFar.begin(), costSoFar.end(), INFINITY);
+        int start = cells[source];
+        costSoFar[start] = 0;
+        firstHop[start] = source;
+        openList.push(start, 0);
+        while (!openList.isEmpty()) {
+            int current = openList.pop();
+            auto edges = graph.getOutgoingEdges(current);
+            for (int i = 0; i < edges.size(); i++) {
+                int target = edges.target(i);
+                float targetCSF = costSoFar[current] + edges.cost(i);
+                if (targetCSF >= costSoFar[target]) { continue; }
+                costSoFar[target] = targetCSF;
+                firstHop[target] = current == start ? cellIndex[target] : firstHop[current];
+                if (openList.contains(target)) { openList.decreaseKey(target, targetCSF); }
+                else { openList.push(target, targetCSF); }
+            }
+        }
+
+        // Each thread writes only its own rows.
+        uint16_t* distanceRow = distances.data() + size_t(source) * n;
+        uint16_t* nextHopRow = nextHops.data() + size_t(source) * n;
+        for (int cell = 0; cell < n; cell++) {
+            float distance = costSoFar[cells[cell]];
+            if (distance == INFINITY) { continue; }
+            distanceRow[cell] = min(float(MAX_DISTANCE), float(round(distance)));
+            nextHopRow[cell] = firstHop[cells[cell]];
+        }
+    }
+}
+
+bool PathTable::load(const string& file) {
+    ifstream in(file, ios::binary);
+    if (!in) { return false; }
+    uint32_t magic;
+    uint64_t fileKey;
+    int count;
+    in.read((char*)&magic, sizeof(magic));
+    in.read((char*)&fileKey, sizeof(fileKey));
+    in.read((char*)&count, sizeof(count));
+    // A graph has no more cells than vertices, so a corrupt count is caught before allocating.
+    if (!in || magic != MAGIC || fileKey != key || count < 0 || count > min(MAX_CELLS, graph->size())) { return false; }
+
+    cells.resize(count);
+    distances.resize(size_t(count) * count);
+    nextHops.resize(size_t(count) * count);
+    in.read((char*)cells.data(), count * sizeof(int));
+    in.read((char*)distances.data(), distances.size() * sizeof(uint16_t));
+    in.read((char*)nextHops.data(), nextHops.size() * sizeof(uint16_t));
+
+    // A truncated file or one with foreign cells is rebuilt.
+    cellIndex.assign(graph->size(), -1);
+    bool valid = bool(in);
+    for (int cell = 0; cell < count && valid; cell++) {
+        valid = cells[cell] >= 0 && cells[cell] < graph->size();
+        if (valid) { cellIndex[cells[cell]] = cell; }
+    }
+    if (!valid) {
+        cells.clear();
+        distances.clear();
+        nextHops.clear();
+    }
+    return valid;
+}
+
+bool PathTable::save(const string& file) const {
+    ofstream out(file, ios::binary);
+    if (!out) { return false; }
+    uint32_t magic = MAGIC;
+    int count = size();
+    out.write((const char*)&magic, sizeof(magic));
+    out.write((const char*)&key, sizeof(key));
+    out.write((const char*)&count, sizeof(count));
+    out.write((const char*)cells.data(), count * sizeof(int));
+    out.write((const char*)distances.data(), distances.size() * sizeof(uint16_t));
+    out.write((const char*)nextHops.data(), nextHops.size() * sizeof(uint16_t));
+    return bool(out);
+}
+
+float PathTable::getDistance(const Location& from, const Location& to) const {
+    if (!contains(from) || !contains(to)) { return -1; }
+    uint16_t distance = distances[size_t(cellIndex[graph->index(from)]) * size() + cellIndex[graph->index(to)]];
+    return distance == UNREACHABLE ? -1 : distance;
+}
+
+void PathTable::getPath(const Location& start, const Location& end, Path& path) const {
+    path.clear();
+    if (getDistance(start, end) < 0) { return; }
+
+    // Follow next hops from start until end (a path to itself is start and end).
+    int current = cellIndex[graph->index(start)];
+    int last = cellIndex[graph->index(end)];
+    path.add(start);
+    if (current == last) { path.add(end); }
+    while (current != last) {
+        current = nextHops[size_t(current) * size() + last];
+        path.add(graph->localize(cells[current]));
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef PATH_TABLE_H
+#define PATH_TABLE_H
+
+#include <vector>
+#include <string>
+#include <stdint.h>
+#include <atomic>
+#include "../graph/graph.h"
+#include "search.h"
+
+using namespace std;
+
+/**
+ * All-pairs distance and next-hop tables of a small static graph, like the 22x22 character
+ * level. One single-source Dijkstra per cell (vertex with an edge) fills a row of each table,
+ * spread over threads. Both tables are n x n uint16s: distances are costs rounded to integers
+ * (exact for the level's integer costs, saturating at MAX_DISTANCE), and next hops are cell
+ * indices, so graphs of up to MAX_CELLS cells are supported (larger ones get an empty table);
+ * at that size each table takes 512 MiB.
+ *
+ * A distance is one lookup and a path is read off in O(path length) by following next hops,
+ * with nothing searched. Tables can be cached to disk, keyed by an FNV-1a hash of the graph.
+ */
+class PathTable
+{
+    private:
+
+    /** Table entry of a cell unreachable from another. */
+    static const uint16_t UNREACHABLE = 0xFFFF;
+
+    /** First bytes of a cache file ("PTB1"). */
+    static const uint32_t MAGIC = 0x31425450;
+
+    /** Graph the tables are of. */
+    GraphHandle graph;
+
+    /** Hash of the graph. */
+    uint64_t key;
+
+    /** Vertex of each cell, and cell of each vertex (-1 for vertices without edges). */
+    vector<int> cells;
+    vector<int> cellIndex;
+
+    /** Distance and next cell from each cell (row) to each cell (column). */
+    vector<uint16_t> distances;
+    vector<uint16_t> nextHops;
+
+    /** Fills the table rows of cells taken from next until none are left (one thread's work). */
+    void buildRows(atomic<int>* next);
+
+    /** Fills the tables using the given number of threads (0 for one per hardware thread). */
+    void build(int threads);
+
+    /** Reads the tables from file, returning false if it is missing or of another graph. */
+    bool load(const string& file);
+
+    /** Writes the tables to file, returning false if it could not be written. */
+    bool save(const string& file) const;
+
+    public:
+
+    /** Largest number of cells, and largest distance stored. */
+    static const int MAX_CELLS = 0x4000;
+    static const int MAX_DISTANCE = 0xFFFE;
+
+    /** Computes the tables of graph. */
+    PathTable(const GraphHandle& graph, int threads = 0);
+
+    /** Reads the tables of graph from the cache directory, or computes and caches them there. */
+    PathTable(const GraphHandle& graph, const string& cacheDirectory, int threads = 0);
+
+    /** Returns the FNV-1a hash of the graph's edges. */
+    static uint64_t hash(const Graph& graph);
+
+    /** Returns the path distance from one location to another (-1 if there is no path). */
+    float getDistance(const Location& from, const Location& to) const;
+
+    /** Fills path with the path from start to end (empty if there is none), reusing its storage. */
+    void getPath(const Location& start, const Location& end, Path& path) const;
+
+    /** Returns true if the location is a cell of the table. */
+    inline bool contains(const Location& location) const {
+        return graph->contains(location) && cellIndex[graph->index(location)] != -1;
+    }
+
+    /** Getters. */
+    inline uint64_t getKey() const { return key; }
+    inline int size() const { return cells.size(); }
+};
+
+#endif
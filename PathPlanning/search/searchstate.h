@@ -0,0 +1,95 @@
+#ifndef SEARCH_STATE_H
+#define SEARCH_STATE_H
+
+#include <vector>
+#include "../graph/graph.h"
+#include "search.h"
+
+using namespace std;
+
+/**
+ * Per-vertex bookkeeping of a search stored as flat arrays indexed by dense vertex index:
+ * cost so far, estimated total cost, parent vertex and a GraphNodeRecordState byte.
+ * Searches read and write these instead of copying GraphNodes into record lists.
+ *
+ * Each vertex is stamped with the generation (search) that last wrote it; a vertex with an
+ * old stamp reads as unvisited, so reset() only bumps the generation and is O(1).
+ */
+class SearchState
+{
+    private:
+
+    /** Accumulated cost of each vertex (CSF). */
+    vector<float> costSoFar;
+
+    /** Accumulated cost plus heuristic of each vertex (ETC = CSF + H). */
+    vector<float> estimatedTotalCost;
+
+    /** Vertex each vertex was reached from (-1 for none). */
+    vector<int> parent;
+
+    /** GraphNodeRecordState of each vertex, one byte each. */
+    vector<unsigned char> state;
+
+    /** Generation in which each vertex's state was last written. */
+    vector<unsigned int> stamp;
+
+    /** Current generation (never 0, which is the stamp of never written vertices). */
+    unsigned int generation;
+
+    public:
+
+    /** Constructs state for vertices in [0, size), all unvisited. */
+    SearchState(int size);
+
+    /** Marks every vertex unvisited again (O(1), by starting a new generation). */
+    void reset();
+
+    /** Setters. */
+    inline void setCostSoFar(int vertex, float csf) { costSoFar[vertex] = csf; }
+    inline void setEstimatedTotalCost(int vertex, float est) { estimatedTotalCost[vertex] = est; }
+    inline void setParent(int vertex, int from) { parent[vertex] = from; }
+    inline void setState(int vertex, GraphNodeRecordState newState) {
+        state[vertex] = newState;
+        stamp[vertex] = generation;
+    }
+
+    /** Getters. */
+    inline float getCostSoFar(int vertex) const { return costSoFar[vertex]; }
+    inline float getEstimatedTotalCost(int vertex) const { return estimatedTotalCost[vertex]; }
+    inline int getParent(int vertex) const { return parent[vertex]; }
+    inline GraphNodeRecordState getState(int vertex) const {
+        return stamp[vertex] == generation ? GraphNodeRecordState(state[vertex]) : GraphNodeRecordState::unvisited;
+    }
+    inline int size() const { return state.size(); }
+
+    /** Returns the bytes of heap the state holds. */
+    inline size_t getHeapBytes() const {
+        return (costSoFar.capacity() + estimatedTotalCost.capacity()) * sizeof(float) + parent.capacity() * sizeof(int) +
+            state.capacity() + stamp.capacity() * sizeof(unsigned int);
+    }
+
+    /**
+     * Fills path with the path from start to end by walking parents back from end
+     * (O(path length), reusing the path's storage), graph being the one searched.
+     */
+    template <class G>
+    void toPath(const G& graph, int start, int end, int exploredNodes, Path& path) const;
+};
+
+template <class G>
+inline void SearchState::toPath(const G& graph, int start, int end, int exploredNodes, Path& path) const {
+    path.clear();
+
+    // Add locations from end back to start (a path to itself is start and end).
+    if (start == end) { path.add(graph.localize(end)); }
+    for (int vertex = end; vertex != -1; vertex = (vertex == start) ? -1 : parent[vertex]) {
+        path.add(graph.localize(vertex));
+    }
+
+    // Locations were added backwards.
+    path.reverse();
+    path.exploredNodes = exploredNodes;
+}
+
+#endif
@@ -0,0 +1,94 @@
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include "../graph/graph.h"
+#include "priorityqueue.h"
+#include "searchstate.h"
+#include "searchcontext.h"
+#include "search.h"
+#include "a*.h"
+#include "slicedsearch.h"
+
+using namespace std;
+using namespace chrono;
+
+SlicedAStar::SlicedAStar(const GraphHandle& graph) :
+    graph(graph), context(graph->size()), start(-1, -1), end(-1, -1), startVertex(-1), endVertex(-1), closedCount(0), expanded(0), status(SEARCH_IDLE) {}
+
+void SlicedAStar::begin(const Location& start_, const Location& end_, const shared_ptr<const Heuristic>& heuristic_) {
+    start = start_;
+    end = end_;
+    heuristic = heuristic_;
+    path.clear();
+    closedCount = 0;
+    expanded = 0;
+
+    // Locations outside of the graph have no path.
+    if (!graph->contains(start) || !graph->contains(end)) {
+        status = SEARCH_COMPLETE;
+        return;
+    }
+
+    // Setup open list and per-vertex state (both indexed by vertex).
+    startVertex = graph->index(start);
+    endVertex = graph->index(end);
+    context.reset();
+    BestFirstOpenList openList(context.getOpenList());
+    AStar::open(start, startVertex, *heuristic, context.getState(), openList);
+    status = SEARCH_IN_PROGRESS;
+}
+
+void SlicedAStar::cancel() {
+    if (status == SEARCH_IN_PROGRESS) { status = SEARCH_IDLE; }
+}
+
+SearchStatus SlicedAStar::step(int maxExpansions, long long maxMicroseconds) {
+    if (status != SEARCH_IN_PROGRESS) { return status; }
+
+    // Resume the open list and per-vertex state of the previous steps.
+    SearchState& state = context.getState();
+    BestFirstOpenList openList(context.getOpenList());
+    int budget = maxExpansions;
+    ExpansionResult result = AStar::expand(*graph, *heuristic, endVertex, state, openList, closedCount, budget, maxMicroseconds);
+    expanded += maxExpansions - budget;
+
+    // The search completes when it reaches the end, or when the open list runs out without reaching it (no path).
+    if (result == END_REACHED) { state.toPath(*graph, startVertex, endVertex, closedCount, path); }
+    if (result != BUDGET_SPENT) { status = SEARCH_COMPLETE; }
+    return status;
+}
+
+SearchScheduler::SearchScheduler(int expansions, long long microseconds) : expansions(expansions), microseconds(microseconds) {}
+
+void SearchScheduler::submit(SlicedAStar& search) {
+    if (find(pending.begin(), pending.end(), &search) == pending.end()) { pending.push_back(&search); }
+}
+
+int SearchScheduler::run() {
+    auto startTime = steady_clock::now();
+    int spent = 0;
+
+    // Serve searches in turn across frames, so the same one is not always first.
+    if (!pending.empty()) { rotate(pending.begin(), pending.begin() + 1, pending.end()); }
+    while (true) {
+        pending.erase(remove_if(pending.begin(), pending.end(), [](SlicedAStar* search) { return !search->isSearching(); }),
+            pending.end());
+        if (pending.empty() || spent >= expansions) { break; }
+
+        // Split what is left evenly; searches that complete early leave theirs to the next round.
+        int share = max(1, (expansions - spent) / (int)pending.size());
+        for (SlicedAStar* search : pending) {
+            long long left = 0;
+            if (microseconds > 0) {
+                left = microseconds - duration_cast<chrono::microseconds>(steady_clock::now() - startTime).count();
+                if (left <= 0) { return spent; }
+            }
+            int before = search->getExpanded();
+            search->step(min(share, expansions - spent), left);
+            spent += search->getExpanded() - before;
+            if (spent >= expansions) { break; }
+        }
+    }
+    return spent;
+}
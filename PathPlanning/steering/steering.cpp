@@ -75,8 +75,8 @@ Arrive::Arrive(const float t, const float r1, const float r2, float s) : Positio
 
 Align::Align(const float t, const float r1, const float r2, float m) : Orientation(t, r1, r2, m) {}
 
-FollowPath::FollowPath(const Path& p, float o, float idx, float pt, float t, float r1, float r2, float s) :
-    Arrive(t, r1, r2, s), path(p) {
+FollowPath::FollowPath(const Path& p, const GridTransform& g, float o, float idx, float pt, float t, float r1, float r2, float s) :
+    Arrive(t, r1, r2, s), path(p), transform(g) {
     pathOffset = o;
     currentPathIndex = idx;
     predictionTime = pt;
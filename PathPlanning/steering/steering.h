@@ -16,6 +16,7 @@
 #include "../math/vmath.h"
 #include "../search/search.h"
 #include "../level/location.h"
+#include "../level/transform.h"
 #include "steeringoutput.h"
 
 using namespace sf;
@@ -261,21 +262,33 @@ class FollowPath : Arrive
 {
     private:
     Path path;
+    GridTransform transform;
     float pathOffset;
     int currentPathIndex;
     float predictionTime;
 
     public:
 
-    FollowPath(const Path& p, float o, float idx, float pt, float t, float r1, float r2, float s);
+    FollowPath(const Path& p, const GridTransform& g, float o, float idx, float pt, float t, float r1, float r2, float s);
+
+    /** Follows a new path from its start, reusing the storage of the current one. */
+    inline void setPath(const Path& p) {
+        path = p;
+        currentPathIndex = 0;
+    }
+
+    /** Follows a longer version of the current path (p starts with it), keeping the current index. */
+    inline void extendPath(const Path& p) {
+        path = p;
+    }
 
     inline SteeringOutput calculateAcceleration(const Kinematic& character, const Kinematic& notUsed) {
         Vector2f futurePosition = character.position + (character.linearVelocity * predictionTime);
-        currentPathIndex = path.getIndex(futurePosition, currentPathIndex);
+        currentPathIndex = path.getIndex(transform, futurePosition, currentPathIndex);
         int newTargetPathIndex = ((currentPathIndex + pathOffset) >= path.size()) ? path.size() - 1 : currentPathIndex + pathOffset;
         Kinematic newTarget;
         cout << newTargetPathIndex << endl;
-        newTarget.position = path.getPosition(newTargetPathIndex);
+        newTarget.position = path.getPosition(transform, newTargetPathIndex);
         if (newTargetPathIndex >= path.size()) {
             newTargetPathIndex = path.size() - 1;
             return SteeringOutput();
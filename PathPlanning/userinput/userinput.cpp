@@ -17,7 +17,15 @@ vector<string> AlgorithmStrings{
 	"Dijkstra's",
 	"A* (manhattan heuristic)",
 	"A* (euclidean heuristic)",
-	"A* (custom heuristic)"
+	"A* (custom heuristic)",
+	"Jump point search (manhattan heuristic)",
+	"Hierarchical A* (manhattan heuristic)",
+	"A* (landmark heuristic)",
+	"Bidirectional Dijkstra's",
+	"Bidirectional A* (manhattan heuristic)",
+	"Weighted A* (manhattan heuristic)",
+	"Optimistic search (manhattan heuristic)",
+	"Focal A* (manhattan heuristic)"
 };
 
 vector<string> VisualizerStrings{
@@ -12,6 +12,14 @@ enum Algorithm
     A_STAR_H1,
     A_STAR_H2,
     A_STAR_CUSTOM,
+    JUMP_POINT,
+    HIERARCHICAL,
+    A_STAR_LANDMARKS,
+    BIDIRECTIONAL_DIJKSTRA,
+    BIDIRECTIONAL_A_STAR,
+    A_STAR_WEIGHTED,
+    A_STAR_OPTIMISTIC,
+    A_STAR_FOCAL,
     INVALID_ALG
 };
 